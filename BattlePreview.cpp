@@ -0,0 +1,403 @@
+// --------------------------- BattlePreview.cpp ---------------------------
+//
+// Implements the battle preview on a GameState snapshot.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "BattlePreview.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// One player of the previewed battle phase: the battle zone as it is in the snapshot and the
+  /// parts of the state the "done" effects and the battle phase change.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct Side
+  {
+    std::array<StateHandle, 7> field; // field after the "done" effects
+    const std::array<StateHandle, 7> *battle;
+    int health;
+    int creatureHealth[7]; // battle creatures
+    TraitSet creatureTraits[7]; // battle creatures
+    bool occupied[7]; // field slots after the creatures returned
+    TraitSet fieldTraits[7]; // traits of the field creatures after the creatures returned
+    int fieldSource[7]; // battle slot a field creature returned from, -1 if it stayed on the field
+    CardKind undying[MAX_STATE_CARDS]; // graveyard creatures with Undying, in graveyard order
+    size_t undyingCount;
+  };
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// @param state   Snapshot
+/// @param catalog Card catalog
+/// @param handle  Card handle of the snapshot (NO_STATE_CARD allowed)
+///
+/// @return true if the handle is a creature
+//---------------------------------------------------------------------------------------------------------------------
+static bool isCreature(const GameState &state, const CardCatalog &catalog, StateHandle handle)
+{
+  return handle != NO_STATE_CARD && catalog.get(state.cards[handle].kind).type == CardType::Creature;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Reads the zones, health and graveyard of a player.
+///
+/// @param state    Snapshot
+/// @param catalog  Card catalog
+/// @param playerId Player 1 or 2
+/// @param side     Receives the player
+//---------------------------------------------------------------------------------------------------------------------
+static void loadSide(const GameState &state, const CardCatalog &catalog, int playerId, Side &side)
+{
+  const PlayerState &player = state.players[playerId - 1];
+  side.field = state.board[(playerId == 1) ? 0 : 2];
+  side.battle = &state.board[(playerId == 1) ? 1 : 3];
+  side.health = player.health;
+  for (int i = 0; i < 7; ++i)
+  {
+    StateHandle handle = (*side.battle)[i];
+    side.creatureHealth[i] = isCreature(state, catalog, handle) ? state.cards[handle].health : 0;
+    side.creatureTraits[i] = isCreature(state, catalog, handle) ? state.cards[handle].traits : TraitSet();
+  }
+
+  side.undyingCount = 0;
+  size_t first = static_cast<size_t>(player.deckCount) + player.handCount;
+  for (size_t i = first; i < first + player.graveyardCount; ++i)
+  {
+    StateHandle handle = player.cards[i];
+    if (isCreature(state, catalog, handle) && state.cards[handle].traits.has(Trait::Undying))
+    {
+      side.undying[side.undyingCount++] = state.cards[handle].kind;
+    }
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Puts a creature into the graveyard. Only Undying creatures are tracked, since only they can
+/// come back.
+///
+/// @param side   Owner
+/// @param kind   Kind of the creature
+/// @param traits Its traits
+//---------------------------------------------------------------------------------------------------------------------
+static void toGraveyard(Side &side, CardKind kind, TraitSet traits)
+{
+  if (traits.has(Trait::Undying) && side.undyingCount < MAX_STATE_CARDS) side.undying[side.undyingCount++] = kind;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Applies the effects of a player's "done" to the field like Game::applyDone: Regenerate heals
+/// on odd rounds, then Poisoned creatures lose 1 health and the dead ones go to the graveyard.
+///
+/// @param state   Snapshot
+/// @param catalog Card catalog
+/// @param side    Player who has yet to play "done"
+//---------------------------------------------------------------------------------------------------------------------
+static void applyDoneEffects(const GameState &state, const CardCatalog &catalog, Side &side)
+{
+  for (int j = 0; j < 7; ++j)
+  {
+    StateHandle handle = side.field[j];
+    if (!isCreature(state, catalog, handle)) continue;
+
+    const CardState &card = state.cards[handle];
+    int health = card.health;
+    const int baseHP = catalog.get(card.kind).baseHP;
+    if (state.roundNumber % 2 == 1 && card.traits.has(Trait::Regenerate) && health < baseHP) health = baseHP;
+    if (!card.traits.has(Trait::Poisoned) || health - 1 > 0) continue;
+    toGraveyard(side, card.kind, card.traits);
+    side.field[j] = NO_STATE_CARD;
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Puts a returning creature into the first free field slot.
+///
+/// @param side   Owner
+/// @param slot   Battle slot it comes from
+/// @param traits Its traits
+///
+/// @return false if the field is full
+//---------------------------------------------------------------------------------------------------------------------
+static bool toField(Side &side, int slot, TraitSet traits)
+{
+  for (int j = 0; j < 7; ++j)
+  {
+    if (side.occupied[j]) continue;
+    side.occupied[j] = true;
+    side.fieldTraits[j] = traits;
+    side.fieldSource[j] = slot;
+    return true;
+  }
+  return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Moves the battle creatures of a player back to the field after the battle, as the
+/// returnBattleToFieldZone step of Game::processBattlePhase does, and removes the Temporary
+/// creatures afterwards. An Undying creature that returns removes every graveyard card of its
+/// kind, like Player::removeFromGraveyard.
+///
+/// @param state   Snapshot
+/// @param catalog Card catalog
+/// @param side    Player whose creatures return
+/// @param fate    Receives the fate of the battle creature of each slot
+//---------------------------------------------------------------------------------------------------------------------
+static void returnCreatures(const GameState &state, const CardCatalog &catalog, Side &side, BattleFate (&fate)[7])
+{
+  for (int j = 0; j < 7; ++j)
+  {
+    StateHandle handle = side.field[j];
+    side.occupied[j] = (handle != NO_STATE_CARD);
+    side.fieldTraits[j] = isCreature(state, catalog, handle) ? state.cards[handle].traits : TraitSet();
+    side.fieldSource[j] = -1;
+  }
+
+  for (int i = 0; i < 7; ++i)
+  {
+    fate[i] = BattleFate::None;
+    StateHandle handle = (*side.battle)[i];
+    if (!isCreature(state, catalog, handle)) continue;
+
+    const CardDefinition &card = catalog.get(state.cards[handle].kind);
+    TraitSet traits = side.creatureTraits[i];
+    if (side.creatureHealth[i] > 0)
+    {
+      fate[i] = BattleFate::Survives;
+    }
+    else if (traits.has(Trait::Regenerate))
+    {
+      fate[i] = BattleFate::Regenerates;
+    }
+    else if (traits.has(Trait::Undying))
+    {
+      fate[i] = BattleFate::Returns;
+      traits = card.baseTraits;
+      traits.remove(Trait::Undying);
+      size_t kept = 0;
+      for (size_t g = 0; g < side.undyingCount; ++g)
+      {
+        if (side.undying[g] != card.kind) side.undying[kept++] = side.undying[g];
+      }
+      side.undyingCount = kept;
+    }
+    else
+    {
+      fate[i] = BattleFate::Dies;
+      toGraveyard(side, card.kind, traits);
+      continue;
+    }
+
+    if (!toField(side, i, traits))
+    {
+      fate[i] = BattleFate::Dies;
+      toGraveyard(side, card.kind, traits);
+    }
+  }
+
+  for (int j = 0; j < 7; ++j)
+  {
+    if (!side.occupied[j] || !side.fieldTraits[j].has(Trait::Temporary)) continue;
+    side.occupied[j] = false;
+    if (side.fieldSource[j] >= 0) fate[side.fieldSource[j]] = BattleFate::Expires;
+    StateHandle handle = (side.fieldSource[j] >= 0) ? (*side.battle)[side.fieldSource[j]] : side.field[j];
+    toGraveyard(side, state.cards[handle].kind, side.fieldTraits[j]);
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// @param side Player after the Temporary creatures left
+///
+/// @return Number of graveyard creatures Undying brings back, one per free field slot
+//---------------------------------------------------------------------------------------------------------------------
+static int undyingReturns(const Side &side)
+{
+  int free = 0;
+  for (bool occupied: side.occupied) free += occupied ? 0 : 1;
+  return min(free, static_cast<int>(side.undyingCount));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Applies a list of health changes to a player the way Player::setHealth does.
+///
+/// @param health  Player health
+/// @param changes Changes in order, 0 = none
+///
+/// @return Net change
+//---------------------------------------------------------------------------------------------------------------------
+static int16_t applyChanges(int &health, const int16_t (&changes)[2])
+{
+  int before = health;
+  for (int16_t change: changes)
+  {
+    if (change != 0) health = max(0, health + change);
+  }
+  return static_cast<int16_t>(health - before);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Walks the slots like Game::processBattlePhase, then the returns to the field and the end of
+/// round checks.
+///
+/// @param state     Snapshot of the game
+/// @param catalog   Catalog of the game's cards
+/// @param maxRounds Round limit
+///
+/// @return The prediction
+//---------------------------------------------------------------------------------------------------------------------
+BattlePreview previewBattle(const GameState &state, const CardCatalog &catalog, int maxRounds)
+{
+  BattlePreview preview;
+  preview.attackerId = state.attackerId;
+  if (state.attackerId != 1 && state.attackerId != 2) return preview;
+
+  Side attacker;
+  Side defender;
+  loadSide(state, catalog, state.attackerId, attacker);
+  loadSide(state, catalog, 3 - state.attackerId, defender);
+  // The battle phase starts with the "done" of the second player; either player may still be due
+  if (!state.gameOver)
+  {
+    const int currentId = state.currentPlayerId;
+    applyDoneEffects(state, catalog, (currentId == state.attackerId) ? attacker : defender);
+    if (state.doneCounter == 0) applyDoneEffects(state, catalog, (currentId == state.attackerId) ? defender : attacker);
+  }
+  preview.attackerHealthBefore = attacker.health;
+  preview.defenderHealthBefore = defender.health;
+
+  const GameResult attackerWins = (state.attackerId == 1) ? GameResult::P1_Wins : GameResult::P2_Wins;
+  const GameResult defenderWins = (state.attackerId == 1) ? GameResult::P2_Wins : GameResult::P1_Wins;
+  bool ended = state.gameOver;
+  preview.result = static_cast<GameResult>(state.result);
+
+  for (int i = 0; i < 7 && !ended; ++i)
+  {
+    if (attacker.health <= 0 && defender.health <= 0)
+    {
+      preview.gameEnds = ended = true;
+      preview.endReason = GameEnd::PlayerDefeated;
+      preview.result = GameResult::Tie;
+      break;
+    }
+
+    SlotPreview &slot = preview.slots[i];
+    slot.reached = true;
+    StateHandle attackerHandle = (*attacker.battle)[i];
+    StateHandle defenderHandle = (*defender.battle)[i];
+    bool attackerPresent = isCreature(state, catalog, attackerHandle);
+    bool defenderPresent = isCreature(state, catalog, defenderHandle);
+    if (attackerPresent) slot.attackerCard = state.cards[attackerHandle].kind;
+    if (defenderPresent) slot.defenderCard = state.cards[defenderHandle].kind;
+    slot.attackerHealth = static_cast<int16_t>(attacker.creatureHealth[i]);
+    slot.defenderHealth = static_cast<int16_t>(defender.creatureHealth[i]);
+
+    if (!attackerPresent)
+    {
+      // A creature on the attacker's field slot blocks the defender's creature
+      if (attacker.field[i] != NO_STATE_CARD || !defenderPresent) continue;
+      slot.directToAttacker = state.cards[defenderHandle].attack;
+      attacker.health = max(0, attacker.health - slot.directToAttacker);
+      if (attacker.health <= 0)
+      {
+        preview.gameEnds = ended = true;
+        preview.endReason = GameEnd::PlayerDefeated;
+        preview.result = defenderWins;
+      }
+      continue;
+    }
+
+    if (!defenderPresent)
+    {
+      slot.directToDefender = state.cards[attackerHandle].attack;
+      defender.health = max(0, defender.health - slot.directToDefender);
+      if (defender.health <= 0)
+      {
+        preview.gameEnds = ended = true;
+        preview.endReason = GameEnd::PlayerDefeated;
+        preview.result = attackerWins;
+      }
+      continue;
+    }
+
+    slot.fight = true;
+    const CardState &attackerCard = state.cards[attackerHandle];
+    const CardState &defenderCard = state.cards[defenderHandle];
+    FightOutcome outcome = FightTable::resolve(
+        {attackerCard.attack, attackerCard.health, catalog.get(attackerCard.kind).baseHP, attackerCard.traits},
+        {defenderCard.attack, defenderCard.health, catalog.get(defenderCard.kind).baseHP, defenderCard.traits});
+    slot.attackerHealth = outcome.attackerHealth;
+    slot.defenderHealth = outcome.defenderHealth;
+    attacker.creatureHealth[i] = outcome.attackerHealth;
+    defender.creatureHealth[i] = outcome.defenderHealth;
+    if (outcome.attackerPoisoned) attacker.creatureTraits[i].add(Trait::Poisoned);
+    if (outcome.defenderPoisoned) defender.creatureTraits[i].add(Trait::Poisoned);
+    slot.attackerPlayerChange = applyChanges(attacker.health, outcome.attackerPlayer);
+    slot.defenderPlayerChange = applyChanges(defender.health, outcome.defenderPlayer);
+  }
+
+  preview.attackerHealthAfter = attacker.health;
+  preview.defenderHealthAfter = defender.health;
+  if (ended) return preview;
+
+  BattleFate fates[7];
+  returnCreatures(state, catalog, attacker, fates);
+  for (int i = 0; i < 7; ++i) preview.slots[i].attackerFate = fates[i];
+  returnCreatures(state, catalog, defender, fates);
+  for (int i = 0; i < 7; ++i) preview.slots[i].defenderFate = fates[i];
+  preview.attackerUndyingReturns = undyingReturns(attacker);
+  preview.defenderUndyingReturns = undyingReturns(defender);
+
+  // Game::incrementRound: the round limit first, then the draw of the next round
+  const int p1Health = (state.attackerId == 1) ? attacker.health : defender.health;
+  const int p2Health = (state.attackerId == 1) ? defender.health : attacker.health;
+  if (state.roundNumber + 1 > maxRounds)
+  {
+    preview.gameEnds = true;
+    preview.endReason = GameEnd::MaxRounds;
+    preview.result = (p1Health > p2Health) ? GameResult::P1_Wins
+                       : (p2Health > p1Health) ? GameResult::P2_Wins : GameResult::Tie;
+  }
+  else if (state.players[0].deckCount == 0 || state.players[1].deckCount == 0)
+  {
+    // The player whose "done" starts the battle phase is the current player then
+    const int lastId = (state.doneCounter == 1) ? state.currentPlayerId : 3 - state.currentPlayerId;
+    const int winnerId = (state.players[lastId - 1].deckCount == 0) ? 3 - lastId : lastId;
+    preview.gameEnds = true;
+    preview.endReason = GameEnd::EmptyDeck;
+    preview.result = (winnerId == 1) ? GameResult::P1_Wins : GameResult::P2_Wins;
+  }
+  return preview;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Takes a snapshot and previews it.
+///
+/// @param game    Game to preview
+/// @param preview Receives the prediction
+///
+/// @return false if the game does not fit a GameState
+//---------------------------------------------------------------------------------------------------------------------
+bool previewBattle(const Game &game, BattlePreview &preview)
+{
+  GameState state;
+  if (!game.saveState(state)) return false;
+  preview = previewBattle(state, game.getCardFactory().getCatalog(), game.getConfig().getMaxRounds());
+  return true;
+}
@@ -0,0 +1,116 @@
+// --------------------------- BattlePreview.hpp ---------------------------
+//
+// Declares the battle preview, which predicts the outcome of the next
+// battle phase from a GameState snapshot without touching the game.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Game.hpp"
+#include "GameState.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Where a battle creature ends up after the battle phase.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class BattleFate : uint8_t
+{
+  None, ///< no creature, or the game ended before creatures returned
+  Survives, ///< returns to the field
+  Regenerates, ///< killed, returns to the field at full health
+  Returns, ///< killed, Undying brings it back to the field with its base stats
+  Dies, ///< goes to the graveyard (killed, or no free field slot)
+  Expires ///< returns, but leaves for the graveyard as a Temporary creature
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Why the game ends with the battle phase.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class GameEnd : uint8_t
+{
+  None, ///< the game continues
+  PlayerDefeated, ///< a player's health reached 0 in the battle
+  MaxRounds, ///< the next round would exceed the round limit
+  EmptyDeck ///< a player cannot draw for the next round
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Prediction for one battle slot.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct SlotPreview
+{
+  CardKind attackerCard = NO_CARD_KIND; ///< battle creature of the attacker
+  CardKind defenderCard = NO_CARD_KIND; ///< battle creature of the defender
+  bool reached = false; ///< false if the game ended in an earlier slot
+  bool fight = false; ///< the two creatures fought
+  int16_t attackerHealth = 0; ///< health of the attacker's creature after the slot
+  int16_t defenderHealth = 0; ///< health of the defender's creature after the slot
+  BattleFate attackerFate = BattleFate::None;
+  BattleFate defenderFate = BattleFate::None;
+  int16_t directToDefender = 0; ///< unblocked damage dealt to the defending player
+  int16_t directToAttacker = 0; ///< unblocked damage dealt to the attacking player
+  int16_t attackerPlayerChange = 0; ///< Brutal and Lifesteal change of the attacking player's health
+  int16_t defenderPlayerChange = 0; ///< Brutal and Lifesteal change of the defending player's health
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Prediction for a whole battle phase.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct BattlePreview
+{
+  std::array<SlotPreview, 7> slots;
+  int attackerId = 0; ///< player attacking this round
+  int attackerHealthBefore = 0;
+  int defenderHealthBefore = 0;
+  int attackerHealthAfter = 0;
+  int defenderHealthAfter = 0;
+  int attackerUndyingReturns = 0; ///< graveyard creatures Undying brings back for the attacker
+  int defenderUndyingReturns = 0; ///< graveyard creatures Undying brings back for the defender
+  bool gameEnds = false; ///< the battle phase ends the game
+  GameEnd endReason = GameEnd::None; ///< why the game ends
+  GameResult result = GameResult::None; ///< result if the game ends
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Predicts the battle phase as if it started in the given state. It first applies the field
+/// effects of the "done" of each player still to play it (Regenerate on odd rounds, Poisoned
+/// damage), then follows Game::processBattlePhase: the slots in order, with direct hits and fights (see
+/// FightTable::resolve), the game ending on a defeated player, then the creatures returning to the
+/// field, Regenerate, Undying, Temporary creatures leaving and Undying creatures coming back from
+/// the graveyard. Then it checks the end of the round like Game::incrementRound: the round limit
+/// and a player who cannot draw. The rest of the round is assumed to be only "done" commands. Only
+/// the snapshot is read, so it can be called any number of times.
+///
+/// @param state     Snapshot of the game
+/// @param catalog   Catalog of the game's cards
+/// @param maxRounds Round limit of the game's config
+///
+/// @return The prediction
+///
+//---------------------------------------------------------------------------------------------------------------------
+BattlePreview previewBattle(const GameState &state, const CardCatalog &catalog, int maxRounds);
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Snapshots the game and predicts its next battle phase. The game is not changed.
+///
+/// @param game    Game to preview
+/// @param preview Receives the prediction
+///
+/// @return false if the game does not fit a GameState (see Game::saveState)
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool previewBattle(const Game &game, BattlePreview &preview);
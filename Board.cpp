@@ -10,6 +10,7 @@
 //--------------------------------------------------------------------------------------------------------------------
 
 #include "Board.hpp"
+#include "RoundSchedule.hpp"
 #include <iostream>
 using namespace std;
 
@@ -28,6 +29,48 @@ Board::Board()
 {
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Binds all four zones to the card pool of the owning game.
+///
+/// @param cards Card pool the zone handles refer to.
+//---------------------------------------------------------------------------------------------------------------------
+void Board::bindCardPool(CardPool &cards)
+{
+  defField.bindCardPool(cards);
+  defBattle.bindCardPool(cards);
+  atkField.bindCardPool(cards);
+  atkBattle.bindCardPool(cards);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Binds all four zones to the undo journal of the game.
+///
+/// @param undo Journal recording the slot changes
+//---------------------------------------------------------------------------------------------------------------------
+void Board::bindUndoJournal(UndoJournal *undo)
+{
+  defField.bindUndoJournal(undo);
+  defBattle.bindUndoJournal(undo);
+  atkField.bindUndoJournal(undo);
+  atkBattle.bindUndoJournal(undo);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Binds all four zones to the state hash of the game, numbering them like GameState::board.
+///
+/// @param stateHash Hash tracking the board slots
+//---------------------------------------------------------------------------------------------------------------------
+void Board::bindStateHash(StateHash *stateHash)
+{
+  atkField.bindStateHash(stateHash, 0);
+  atkBattle.bindStateHash(stateHash, 1);
+  defField.bindStateHash(stateHash, 2);
+  defBattle.bindStateHash(stateHash, 3);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 ///
 /// Enables or disables automatic printing of the board during the game.
@@ -44,18 +87,17 @@ void Board::setPrinting(bool enabled)
 ///
 /// Prints the current state of the game board based on the given round number.
 /// Displays both players' field and battle zones with proper orientation,
-/// depending on who is the attacker.
+/// depending on who is the attacker. The board is assembled in a reused buffer from cached
+/// card tiles and written to the stream in one call.
 ///
 /// @param roundNumber The current round number used to determine player orientation.
+/// @param os Stream the board is written to.
 //---------------------------------------------------------------------------------------------------------------------
-void Board::print(int roundNumber) const
+void Board::print(int roundNumber, ostream &os) const
 {
   if (!printing) return; // skip if printing is turned off
 
-  bool p1OnBottom = (roundNumber == 1 || roundNumber == 4 || roundNumber == 5 ||
-                     roundNumber == 8 || roundNumber == 9 || roundNumber == 12 ||
-                     roundNumber == 13 || roundNumber == 16 || roundNumber == 17 ||
-                     roundNumber == 20 || roundNumber == 21 || roundNumber == 24);
+  bool p1OnBottom = isPlayer1AttackerRound(roundNumber);
 
   // Dynamically assign zones based on who is attacker (bottom)
   const Zone &topField = p1OnBottom ? defField : atkField;
@@ -63,62 +105,46 @@ void Board::print(int roundNumber) const
   const Zone &bottomField = p1OnBottom ? atkField : defField;
   const Zone &bottomBattle = p1OnBottom ? atkBattle : defBattle;
 
-  int topPlayerId;
-  int bottomPlayerId;
-
-  if (roundNumber == 1 || roundNumber == 4 || roundNumber == 5 ||
-      roundNumber == 8 || roundNumber == 9 || roundNumber == 12 ||
-      roundNumber == 13 || roundNumber == 16 || roundNumber == 17 ||
-      roundNumber == 20 || roundNumber == 21 || roundNumber == 24)
-  {
-    topPlayerId = 2;
-    bottomPlayerId = 1;
-  }
-  else
-  {
-    topPlayerId = 1;
-    bottomPlayerId = 2;
-  };
+  int topPlayerId = p1OnBottom ? 2 : 1;
+  int bottomPlayerId = p1OnBottom ? 1 : 2;
 
+  frame.clear();
 
   // --- Defender border line ---
-  cout
-      << "================================== DEFENDER: PLAYER "
-      << topPlayerId
-      << " ===================================\n";
+  frame += "================================== DEFENDER: PLAYER ";
+  frame += static_cast<char>('0' + topPlayerId);
+  frame += " ===================================\n";
 
   // --- Defender's Field Zone (7 slots side by side) ---
-  topField.printZone();
+  topField.printZone(frame, tiles);
 
   // --- Divider between Field and Battle zones ---
-  cout
-      << "===[---------]=[---------]=[---------]=[---------]"
+  frame += "===[---------]=[---------]=[---------]=[---------]"
       "=[---------]=[---------]=[---------]===\n";
 
   // --- Defender's Battle Zone ---
-  topBattle.printZone();
+  topBattle.printZone(frame, tiles);
 
   // --- Lane index markers between defender & attacker battle rows ---
-  cout
-      << "~~~[~~~ 1 ~~~]~[~~~ 2 ~~~]~[~~~ 3 ~~~]"
+  frame += "~~~[~~~ 1 ~~~]~[~~~ 2 ~~~]~[~~~ 3 ~~~]"
       "~[~~~ 4 ~~~]~[~~~ 5 ~~~]~[~~~ 6 ~~~]~[~~~ 7 ~~~]~~~\n";
 
   // --- Attacker's Battle Zone ---
-  bottomBattle.printZone();
+  bottomBattle.printZone(frame, tiles);
 
   // --- Divider between Battle and Field zones ---
-  cout
-      << "===[---------]=[---------]=[---------]=[---------]"
+  frame += "===[---------]=[---------]=[---------]=[---------]"
       "=[---------]=[---------]=[---------]===\n";
 
   // --- Attacker's Field Zone ---
-  bottomField.printZone();
+  bottomField.printZone(frame, tiles);
 
   // --- Attacker border line ---
-  cout
-      << "================================== ATTACKER: PLAYER "
-      << bottomPlayerId
-      << " ===================================\n";
+  frame += "================================== ATTACKER: PLAYER ";
+  frame += static_cast<char>('0' + bottomPlayerId);
+  frame += " ===================================\n";
+
+  os.write(frame.data(), static_cast<streamsize>(frame.size()));
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -25,6 +25,33 @@ public:
   // -------------------------------------------------------------
   Board();
 
+  // -------------------------------------------------------------
+  //
+  // Binds all four zones to the card pool of the owning game.
+  //
+  // @param cards Card pool the zone handles refer to.
+  //
+  // -------------------------------------------------------------
+  void bindCardPool(CardPool &cards);
+
+  // -------------------------------------------------------------
+  //
+  // Binds all four zones to the undo journal of the owning game.
+  //
+  // @param undo Journal recording the slot changes.
+  //
+  // -------------------------------------------------------------
+  void bindUndoJournal(UndoJournal *undo);
+
+  // -------------------------------------------------------------
+  //
+  // Binds all four zones to the state hash of the owning game.
+  //
+  // @param stateHash Hash tracking the board slots.
+  //
+  // -------------------------------------------------------------
+  void bindStateHash(StateHash *stateHash);
+
   // -------------------------------------------------------------
   //
   // Enables or disables automatic board printing.
@@ -40,9 +67,10 @@ public:
   // Adjusts which player is on top/bottom for visualization.
   //
   // @param roundNumber The round number used to determine layout.
+  // @param os          Stream the board is written to.
   //
   // -------------------------------------------------------------
-  void print(int roundNumber) const;
+  void print(int roundNumber, std::ostream &os) const;
 
   // -------------------------------------------------------------
   //
@@ -72,10 +100,20 @@ public:
 
   Zone &attackerBattle();
 
+  const Zone &defenderField() const { return defField; }
+
+  const Zone &defenderBattle() const { return defBattle; }
+
+  const Zone &attackerField() const { return atkField; }
+
+  const Zone &attackerBattle() const { return atkBattle; }
+
 private:
   bool printing;
   Zone defField;
   Zone defBattle;
   Zone atkField;
   Zone atkBattle;
+  mutable CardTileCache tiles; // rendered card art, reused across prints
+  mutable std::string frame; // text of the board being printed
 };
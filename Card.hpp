@@ -1,8 +1,8 @@
 // --------------------------- Card.hpp ---------------------------
 //
-// This file defines the abstract base class Card and the CardType enum.
-// It provides common properties and interface for all card types,
-// such as name, ID, mana cost, and virtual methods for printing and resetting.
+// This file defines the abstract base class Card. It provides the common
+// interface for all card types, such as name, ID, mana cost (read from the
+// shared CardDefinition), and virtual methods for printing and resetting.
 //
 // Group: 051
 //
@@ -12,46 +12,31 @@
 #ifndef CARD_HPP
 #define CARD_HPP
 
+#include <ostream>
 #include <string>
+#include "CardDefinition.hpp"
 
 using namespace std; // bring in std symbols for clarity
 
-//-----------------------------------------------------------------------------
-// CardType: defines the category of a card (creature vs. spell)
-//-----------------------------------------------------------------------------
-enum class CardType
-{
-  Creature, // creature type: has attack/defense stats
-  Spell // spell type: one-time effect
-};
-
 //-----------------------------------------------------------------------------
 // Card: abstract base class for all cards in the game
 //-----------------------------------------------------------------------------
 class Card
 {
 protected:
-  string id; // unique identifier for the card
-  string name; // display name of the card
-  int manaCost; // mana required to play the card
-  CardType type; // type of the card (creature/spell)
+  const CardDefinition *definition; // shared static data (ID, name, cost, ...)
 
 public:
   // -------------------------------------------------------------
   //
   // Constructor for a Card.
   //
-  // @param id        Unique ID for this card
-  // @param name      Human-readable card name
-  // @param manaCost  Mana required to play
-  // @param type      CardType enum value
+  // @param definition  Static data of the card kind; must outlive
+  //                    the card (it is owned by the CardCatalog)
   //
   // -------------------------------------------------------------
-  Card(const string &id, const string &name, int manaCost, CardType type)
-    : id(id)
-      , name(name)
-      , manaCost(manaCost)
-      , type(type)
+  explicit Card(const CardDefinition &definition)
+    : definition(&definition)
   {
   }
 
@@ -67,8 +52,19 @@ public:
   // Prints all relevant details of the card.
   // Must be overridden by derived classes.
   //
+  // @param os Stream the card is written to
   // -------------------------------------------------------------
-  virtual void printCardDetails() const = 0;
+  virtual void printCardDetails(std::ostream &os) const = 0;
+
+  // -------------------------------------------------------------
+  //
+  // Returns the interned kind of the card. Two cards with the same
+  // ID always have the same kind.
+  //
+  // @return CardKind index
+  //
+  // -------------------------------------------------------------
+  CardKind getKind() const { return definition->kind; }
 
   // -------------------------------------------------------------
   //
@@ -77,7 +73,7 @@ public:
   // @return string ID
   //
   // -------------------------------------------------------------
-  string getID() const { return id; }
+  const string &getID() const { return definition->id; }
 
   // -------------------------------------------------------------
   //
@@ -86,7 +82,7 @@ public:
   // @return string name
   //
   // -------------------------------------------------------------
-  string getName() const { return name; }
+  const string &getName() const { return definition->name; }
 
   // -------------------------------------------------------------
   //
@@ -95,7 +91,16 @@ public:
   // @return int mana cost
   //
   // -------------------------------------------------------------
-  int getManaCost() const { return manaCost; }
+  int getManaCost() const { return definition->manaCost; }
+
+  // -------------------------------------------------------------
+  //
+  // Returns the shared static data of the card.
+  //
+  // @return CardDefinition from the catalog
+  //
+  // -------------------------------------------------------------
+  const CardDefinition &getDefinition() const { return *definition; }
 
   // -------------------------------------------------------------
   //
@@ -104,7 +109,7 @@ public:
   // @return CardType enum
   //
   // -------------------------------------------------------------
-  CardType getType() const { return type; }
+  CardType getType() const { return definition->type; }
 
   // -------------------------------------------------------------
   //
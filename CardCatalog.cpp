@@ -0,0 +1,239 @@
+// --------------------------- CardCatalog.cpp ---------------------------
+//
+// This file implements the CardCatalog: parsing the card data files into
+// contiguous definitions and resolving card IDs to kinds.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// -----------------------------------------------------------------------
+#include "CardCatalog.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <iostream>
+
+using namespace std; // bring in std symbols for brevity
+
+// -------------------------------------------------------------
+// Parses the creature file first and the spell file second, so
+// an ID defined in both resolves to the creature. The fight
+// table is built once the definitions are final.
+//
+// @param creaturePath Path to the creature data file.
+// @param spellPath Path to the spell data file.
+// @return Shared read-only catalog.
+// -------------------------------------------------------------
+shared_ptr<const CardCatalog> CardCatalog::load(const string &creaturePath, const string &spellPath)
+{
+  shared_ptr<CardCatalog> catalog(new CardCatalog());
+  catalog->loadCreatureCards(creaturePath);
+  catalog->loadSpellCards(spellPath);
+  catalog->fights.build(catalog->definitions);
+  return catalog;
+}
+
+// -------------------------------------------------------------
+// Looks up an uppercase ID and appends a definition slot for it
+// if it is new. Repeated IDs overwrite the existing slot.
+//
+// @param id Uppercase card identifier.
+// @return Definition slot of the ID.
+// -------------------------------------------------------------
+CardDefinition &CardCatalog::intern(const string &id)
+{
+  auto it = kinds.find(id);
+  if (it != kinds.end()) return definitions[it->second];
+
+  CardKind kind = static_cast<CardKind>(definitions.size());
+  kinds.emplace(id, kind);
+  CardDefinition &definition = definitions.emplace_back();
+  definition.kind = kind;
+  definition.id = id;
+  return definition;
+}
+
+// -------------------------------------------------------------
+// Parses a trait string and returns the corresponding Trait enum.
+// Unknown traits are logged and defaulted to Brutal.
+//
+// @param traitStr The string representation of a trait.
+// @return Corresponding Trait enum value.
+// -------------------------------------------------------------
+Trait CardCatalog::parseTrait(const string &traitStr)
+{
+  if (traitStr == "Brutal") return Trait::Brutal;
+  if (traitStr == "Challenger") return Trait::Challenger;
+  if (traitStr == "First Strike") return Trait::FirstStrike;
+  if (traitStr == "Haste") return Trait::Haste;
+  if (traitStr == "Lifesteal") return Trait::Lifesteal;
+  if (traitStr == "Poisoned") return Trait::Poisoned;
+  if (traitStr == "Regenerate") return Trait::Regenerate;
+  if (traitStr == "Temporary") return Trait::Temporary;
+  if (traitStr == "Undying") return Trait::Undying;
+  if (traitStr == "Venomous") return Trait::Venomous;
+
+  cerr << "[WARNING] Unknown trait: " << traitStr << endl;
+  return Trait::Brutal; // fallback trait
+}
+
+// -------------------------------------------------------------
+// Loads creature card definitions from creatureCards.txt.
+// Each card is parsed and stored under its interned kind.
+// Lines starting with '#' or empty lines are skipped.
+//
+// @param path Path to the creature data file.
+// -------------------------------------------------------------
+void CardCatalog::loadCreatureCards(const string &path)
+{
+  ifstream file(path);
+  if (!file.is_open())
+  {
+    cerr << "Failed to open creatureCards.txt" << endl;
+    return;
+  }
+
+  string line;
+  while (getline(file, line))
+  {
+    // Skip comment or empty lines
+    if (line.empty() || line[0] == '#') continue;
+
+    stringstream ss(line);
+    string id, name, manaStr, atkStr, hpStr, traitsStr;
+    getline(ss, id, ';');
+    if (id == "ID") continue;
+    getline(ss, name, ';');
+    getline(ss, manaStr, ';');
+    getline(ss, atkStr, ';');
+    getline(ss, hpStr, ';');
+    getline(ss, traitsStr, ';');
+
+    // parsing traits into a bitmask
+    TraitSet baseTraits;
+    stringstream tss(traitsStr);
+    string traitToken;
+    while (getline(tss, traitToken, ','))
+    {
+      if (!traitToken.empty())
+      {
+        /*remove leading spaces*/
+        traitToken.erase(0, traitToken.find_first_not_of(" \t\r\n"));
+        traitToken.erase(traitToken.find_last_not_of(" \t\r\n") + 1);
+
+        baseTraits.add(parseTrait(traitToken));
+      }
+    }
+
+
+    // Normalize ID to uppercase
+    transform(id.begin(), id.end(), id.begin(), ::toupper);
+
+    int manaCost = 0, baseAttack = 0, baseHealth = 0;
+    try
+    {
+      manaCost = stoi(manaStr);
+      baseAttack = stoi(atkStr);
+      baseHealth = stoi(hpStr);
+    }
+    catch (const invalid_argument &e)
+    {
+      cerr << "Invalid number format in line: " << line << endl;
+      continue; // skip invalid entry
+    } catch (const out_of_range &e)
+    {
+      cerr << "Number out of range in line: " << line << endl;
+      continue; // skip out-of-range entry
+    }
+
+    CardDefinition &definition = intern(id);
+    definition.type = CardType::Creature;
+    definition.name = name;
+    definition.manaCost = manaCost;
+    definition.baseATK = baseAttack;
+    definition.baseHP = baseHealth;
+    definition.baseTraits = baseTraits;
+  }
+}
+
+// -------------------------------------------------------------
+// Loads spell card definitions from spellCards.txt.
+// Each spell is stored under its interned kind; an ID that is
+// already a creature keeps its creature definition.
+//
+// @param path Path to the spell data file.
+// -------------------------------------------------------------
+void CardCatalog::loadSpellCards(const string &path)
+{
+  ifstream file(path);
+  if (!file.is_open())
+  {
+    cerr << "Failed to open spellCards.txt" << endl;
+    return;
+  }
+
+  string line;
+  while (getline(file, line))
+  {
+    if (line.empty() || line[0] == '#') continue;
+
+    stringstream ss(line);
+    string id, name, manaStr, spellTypeStr;
+    getline(ss, id, ';');
+    getline(ss, name, ';');
+    getline(ss, manaStr, ';');
+    getline(ss, spellTypeStr, ';');
+
+    transform(id.begin(), id.end(), id.begin(), ::toupper);
+
+    // Handle variable mana costs (e.g., X spells)
+    int manaCost = (manaStr == "X" || manaStr == "x") ? -1 : stoi(manaStr);
+
+    // Determine SpellType enum
+    SpellType spellType = SpellType::General;
+    if (spellTypeStr == "General") spellType = SpellType::General;
+    else if (spellTypeStr == "Target") spellType = SpellType::Target;
+    else if (spellTypeStr == "Graveyard") spellType = SpellType::Graveyard;
+
+    if (kinds.count(id) && definitions[kinds.at(id)].type == CardType::Creature) continue;
+    CardDefinition &definition = intern(id);
+    definition.type = CardType::Spell;
+    definition.name = name;
+    definition.manaCost = manaCost;
+    definition.spellType = spellType;
+    definition.effect = spellEffectFromID(id);
+  }
+}
+
+// -------------------------------------------------------------
+// Resolves a card ID to its kind. IDs from the game are usually
+// uppercase already, so the uppercase copy is only made on a miss.
+//
+// @param id Card identifier (case-insensitive).
+// @return Kind of the card or NO_CARD_KIND.
+// -------------------------------------------------------------
+CardKind CardCatalog::findKind(const string &id) const
+{
+  auto it = kinds.find(id);
+  if (it == kinds.end())
+  {
+    string upperId = id;
+    transform(upperId.begin(), upperId.end(), upperId.begin(), ::toupper);
+    it = kinds.find(upperId);
+    if (it == kinds.end()) return NO_CARD_KIND;
+  }
+  return it->second;
+}
+
+// -------------------------------------------------------------
+// Looks up the definition of a card ID.
+//
+// @param id Card identifier (case-insensitive).
+// @return Pointer to the definition or nullptr.
+// -------------------------------------------------------------
+const CardDefinition *CardCatalog::find(const string &id) const
+{
+  CardKind kind = findKind(id);
+  return kind == NO_CARD_KIND ? nullptr : &definitions[kind];
+}
@@ -0,0 +1,139 @@
+// --------------------------- CardCatalog.hpp ---------------------------
+//
+// This file declares the CardCatalog, the immutable set of all card
+// definitions loaded from the data files. Definitions are stored
+// contiguously and indexed by CardKind. A loaded catalog is never
+// modified, so any number of games and threads can share one instance.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// -----------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "CardDefinition.hpp"
+#include "FightTable.hpp"
+
+using namespace std; // bring in std symbols for clarity
+
+// -------------------------------------------------------------
+// CardCatalog: read-only card definitions indexed by CardKind,
+// plus the ID -> kind lookup used at the input edge.
+// -------------------------------------------------------------
+class CardCatalog
+{
+private:
+  vector<CardDefinition> definitions; // all definitions, definitions[k].kind == k
+  FightTable fights; // outcomes of fights between unchanged creatures
+  unordered_map<string, CardKind> kinds; // uppercase ID -> kind
+
+  CardCatalog() = default;
+
+  // -------------------------------------------------------------
+  //
+  // Returns the definition slot of an uppercase ID, appending a
+  // new one if the ID has not been seen before.
+  //
+  // @param id Uppercase card identifier
+  // @return Definition slot for the ID
+  //
+  // -------------------------------------------------------------
+  CardDefinition &intern(const string &id);
+
+  // -------------------------------------------------------------
+  //
+  // Parses a trait string and returns the corresponding enum.
+  //
+  // @param traitStr String representation of a trait
+  // @return Trait enum
+  //
+  // -------------------------------------------------------------
+  static Trait parseTrait(const string &traitStr);
+
+  // -------------------------------------------------------------
+  //
+  // Loads creature definitions.
+  // Expected format: ID;Name;ManaCost;BaseAttack;BaseHealth;Traits
+  //
+  // @param path Path to the creature data file
+  //
+  // -------------------------------------------------------------
+  void loadCreatureCards(const string &path);
+
+  // -------------------------------------------------------------
+  //
+  // Loads spell definitions.
+  // Expected format: ID;Name;ManaCost;SpellType
+  //
+  // @param path Path to the spell data file
+  //
+  // -------------------------------------------------------------
+  void loadSpellCards(const string &path);
+
+public:
+  // -------------------------------------------------------------
+  //
+  // Reads and parses both card data files into a new catalog.
+  // Call once per process and share the result between games.
+  //
+  // @param creaturePath Path to the creature data file
+  // @param spellPath    Path to the spell data file
+  // @return Shared read-only catalog
+  //
+  // -------------------------------------------------------------
+  static shared_ptr<const CardCatalog> load(const string &creaturePath = "data/creatureCards.txt",
+                                            const string &spellPath = "data/spellCards.txt");
+
+  // -------------------------------------------------------------
+  //
+  // Resolves a card ID to its kind (case-insensitive).
+  //
+  // @param id Card identifier (e.g., "ZMBFY")
+  // @return CardKind if found, otherwise NO_CARD_KIND
+  //
+  // -------------------------------------------------------------
+  CardKind findKind(const string &id) const;
+
+  // -------------------------------------------------------------
+  //
+  // Looks up the definition of a card ID (case-insensitive).
+  //
+  // @param id Card identifier
+  // @return Pointer to the definition, or nullptr if unknown
+  //
+  // -------------------------------------------------------------
+  const CardDefinition *find(const string &id) const;
+
+  // -------------------------------------------------------------
+  //
+  // Returns the definition of a valid kind.
+  //
+  // @param kind Interned card kind (< size())
+  // @return Definition of the kind
+  //
+  // -------------------------------------------------------------
+  const CardDefinition &get(CardKind kind) const { return definitions[kind]; }
+
+  // -------------------------------------------------------------
+  //
+  // Returns the number of card kinds.
+  //
+  // @return Number of definitions
+  //
+  // -------------------------------------------------------------
+  size_t size() const { return definitions.size(); }
+
+  // -------------------------------------------------------------
+  //
+  // Returns the fight outcomes precomputed for the creatures of
+  // this catalog.
+  //
+  // @return Fight table
+  //
+  // -------------------------------------------------------------
+  const FightTable &getFightTable() const { return fights; }
+};
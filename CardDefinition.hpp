@@ -0,0 +1,123 @@
+// --------------------------- CardDefinition.hpp ---------------------------
+//
+// This file defines the static description of a card kind: the CardKind
+// index, the CardType and spell enums, and the CardDefinition record that
+// card instances share (flyweight) instead of copying.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include "Trait.hpp"
+
+using namespace std; // bring in std symbols for clarity
+
+//-----------------------------------------------------------------------------
+// CardKind: dense index of a card definition, interned by the CardCatalog
+// when the card data is loaded. Card identity checks compare kinds; the
+// string ID is only needed for input parsing and output.
+//-----------------------------------------------------------------------------
+using CardKind = uint16_t;
+
+constexpr CardKind NO_CARD_KIND = UINT16_MAX; // returned for unknown card IDs
+
+//-----------------------------------------------------------------------------
+// CardType: defines the category of a card (creature vs. spell)
+//-----------------------------------------------------------------------------
+enum class CardType
+{
+  Creature, // creature type: has attack/defense stats
+  Spell // spell type: one-time effect
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Enum class representing different types of spell behaviors.
+///
+/// - General   → one-time effect, no specific target
+/// - Target    → directed at a specific card or player
+/// - Graveyard → interacts with graveyard cards
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class SpellType
+{
+  General, ///< one-time effect without specific target
+  Target, ///< effect directed at a specific card or player
+  Graveyard ///< effect interacts with cards in the graveyard
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Effect a spell resolves to. Resolved once from the card ID when the spell data is loaded,
+/// so casting dispatches on an enum instead of comparing ID strings.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class SpellEffect
+{
+  None, ///< unknown spell ID, casting has no effect
+  BattleCry, ///< BTLCY
+  Meteor, ///< METOR
+  Fireball, ///< FIRBL
+  Clone, ///< CLONE
+  Curse, ///< CURSE
+  Shock, ///< SHOCK
+  Mobilize, ///< MOBLZ
+  RapidRush, ///< RRUSH
+  Shield, ///< SHILD
+  Amputate, ///< AMPUT
+  FinalAct, ///< FINAL
+  Loyalty, ///< LYLTY
+  Zombify, ///< ZMBFY
+  Bloodlust, ///< BLOOD
+  HeroicMemory, ///< MEMRY
+  Revive ///< REVIV
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Maps an (uppercase) spell card ID to its effect.
+///
+/// @param id Spell card ID
+///
+/// @return The matching SpellEffect, SpellEffect::None if the ID has no implemented effect
+///
+//---------------------------------------------------------------------------------------------------------------------
+inline SpellEffect spellEffectFromID(const string &id)
+{
+  static const pair<const char *, SpellEffect> effects[] = {
+    {"BTLCY", SpellEffect::BattleCry}, {"METOR", SpellEffect::Meteor}, {"FIRBL", SpellEffect::Fireball},
+    {"CLONE", SpellEffect::Clone}, {"CURSE", SpellEffect::Curse}, {"SHOCK", SpellEffect::Shock},
+    {"MOBLZ", SpellEffect::Mobilize}, {"RRUSH", SpellEffect::RapidRush}, {"SHILD", SpellEffect::Shield},
+    {"AMPUT", SpellEffect::Amputate}, {"FINAL", SpellEffect::FinalAct}, {"LYLTY", SpellEffect::Loyalty},
+    {"ZMBFY", SpellEffect::Zombify}, {"BLOOD", SpellEffect::Bloodlust}, {"MEMRY", SpellEffect::HeroicMemory},
+    {"REVIV", SpellEffect::Revive}
+  };
+  for (const auto &[effectId, effect]: effects)
+  {
+    if (id == effectId) return effect;
+  }
+  return SpellEffect::None;
+}
+
+// -------------------------------------------------------------
+// CardDefinition: static data of one card kind. Creature fields
+// are unused for spells and spell fields unused for creatures.
+// -------------------------------------------------------------
+struct CardDefinition
+{
+  CardKind kind = NO_CARD_KIND; // index of this definition in the catalog
+  CardType type = CardType::Creature; // creature or spell
+  string id; // uppercase card ID
+  string name; // display name
+  int manaCost = 0; // -1 for variable (X) costs
+  int baseATK = 0; // creature base attack
+  int baseHP = 0; // creature base health
+  TraitSet baseTraits; // creature base traits
+  SpellType spellType = SpellType::General; // spell category
+  SpellEffect effect = SpellEffect::None; // spell effect
+};
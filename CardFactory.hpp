@@ -1,8 +1,8 @@
 // --------------------------- CardFactory.hpp ---------------------------
 //
 // This file declares the CardFactory class, which is responsible for
-// loading and instantiating card objects from configuration files.
-// It manages both creature and spell card prototypes.
+// instantiating card objects from the shared CardCatalog of card
+// definitions into the per-game CardPool.
 //
 // Group: 051
 //
@@ -11,69 +11,90 @@
 #pragma once
 
 #include <string>
-#include <map>
 #include <memory>
-#include <vector>
 #include "Card.hpp"
+#include "CardCatalog.hpp"
+#include "CardPool.hpp"
 #include "CreatureCard.hpp"
 #include "SpellCard.hpp"
 
 using namespace std; // bring in std symbols for clarity
 
 // -------------------------------------------------------------
-// CardFactory: responsible for loading card prototypes and
-// creating new instances of cards based on ID.
+// CardFactory: creates new card instances from the definitions
+// of a shared, read-only CardCatalog. The instances live in the
+// factory's CardPool and are referred to by CardHandle.
 // -------------------------------------------------------------
 class CardFactory
 {
 private:
+  shared_ptr<const CardCatalog> catalog; // Shared card definitions
+  CardPool pool; // Card instances of this game
+
+public:
   // -------------------------------------------------------------
-  // Maps that store card prototypes by uppercase ID
+  //
+  // Creates a factory for the cards of a loaded catalog.
+  //
+  // @param catalog Card definitions (see CardCatalog::load)
+  //
   // -------------------------------------------------------------
-  map<string, shared_ptr<Card> > creatureCards; // Loaded creature card templates
-  map<string, shared_ptr<Card> > spellCards; // Loaded spell card templates
+  explicit CardFactory(shared_ptr<const CardCatalog> catalog);
 
   // -------------------------------------------------------------
   //
-  // Parses a trait string and returns the corresponding enum.
+  // Returns the catalog of card definitions.
   //
-  // @param traitStr String representation of a trait
-  // @return Trait enum
+  // @return Read-only CardCatalog
   //
   // -------------------------------------------------------------
-  Trait parseTrait(const string &traitStr);
+  const CardCatalog &getCatalog() const { return *catalog; }
+
+  // -------------------------------------------------------------
+  //
+  // Returns the arena holding all created card instances.
+  //
+  // @return CardPool of this factory
+  //
+  // -------------------------------------------------------------
+  CardPool &getPool() { return pool; }
+
+  const CardPool &getPool() const { return pool; }
 
-public:
   // -------------------------------------------------------------
   //
-  // Loads all creature card definitions from config file into map.
-  // Expected format: ID;Name;ManaCost;BaseAttack;BaseHealth;Traits
+  // Resolves a card ID to its interned kind (case-insensitive).
+  //
+  // @param id Card identifier (e.g., "ZMBFY")
+  // @return CardKind if found, otherwise NO_CARD_KIND
   //
   // -------------------------------------------------------------
-  void loadCreatureCards();
+  CardKind findKind(const string &id) const { return catalog->findKind(id); }
 
   // -------------------------------------------------------------
   //
-  // Loads all spell card definitions from config file into map.
-  // Expected format: ID;Name;ManaCost;SpellType
+  // Instantiates a new Card object of the given kind.
+  //
+  // @param kind Interned card kind
+  // @return Handle of the new card if the kind is known, otherwise NO_CARD
   //
   // -------------------------------------------------------------
-  void loadSpellCards();
+  CardHandle createCard(CardKind kind);
 
   // -------------------------------------------------------------
   //
   // Instantiates a new Card object by given ID. Performs a case-
-  // insensitive lookup and returns a deep copy of the prototype.
+  // insensitive lookup of the definition.
   //
   // @param id Card identifier (e.g., "ZMBFY")
-  // @return shared_ptr<Card> if found, otherwise nullptr
+  // @return Handle of the new card if found, otherwise NO_CARD
   //
   // -------------------------------------------------------------
-  shared_ptr<Card> createCardByID(const string &id);
+  CardHandle createCardByID(const string &id);
 
   // -------------------------------------------------------------
   //
-  // Checks if the given card ID is valid (present in either map).
+  // Checks if the given card ID is valid (a creature or spell).
   //
   // @param id Card identifier
   // @return true if valid, false otherwise
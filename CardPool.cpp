@@ -0,0 +1,140 @@
+// --------------------------- CardPool.cpp ---------------------------
+//
+// Implementation of the CardPool arena: creating card instances and
+// resolving handles.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "CardPool.hpp"
+#include "StateHash.hpp"
+#include "UndoJournal.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Appends a new instance to the storage of its card type. A full pool is an error rather than a
+/// handle that wraps onto an older card.
+///
+/// @param definition Catalog definition of the card
+///
+/// @return Handle of the new card
+///
+//---------------------------------------------------------------------------------------------------------------------
+CardHandle CardPool::create(const CardDefinition &definition)
+{
+  if (entries.size() >= MAX_CARDS)
+  {
+    throw length_error("A game cannot hold more than " + to_string(MAX_CARDS) + " card instances");
+  }
+  Entry entry{definition.type, 0};
+  if (definition.type == CardType::Creature)
+  {
+    entry.index = static_cast<uint32_t>(creatures.size());
+    creatures.emplace_back(definition);
+    if (hash)
+    {
+      creatures.back().bindStateHash(hash, static_cast<CardHandle>(entries.size()));
+      creatures.back().hashStats(*hash);
+    }
+  }
+  else
+  {
+    entry.index = static_cast<uint32_t>(spells.size());
+    spells.emplace_back(definition);
+  }
+  if (hash) hash->toggle(HashFeature::Kind, static_cast<uint32_t>(entries.size()), static_cast<uint64_t>(definition.kind));
+  entries.push_back(entry);
+  return static_cast<CardHandle>(entries.size() - 1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Resolves a handle to its card instance.
+///
+/// @param handle Card handle
+///
+/// @return Pointer to the card, or nullptr
+///
+//---------------------------------------------------------------------------------------------------------------------
+Card *CardPool::get(CardHandle handle)
+{
+  if (handle >= entries.size()) return nullptr;
+  const Entry &entry = entries[handle];
+  if (entry.type == CardType::Creature)
+  {
+    if (journal && journal->isRecording()) journal->saveCreature(handle, creatures[entry.index]);
+    return &creatures[entry.index];
+  }
+  return &spells[entry.index];
+}
+
+const Card *CardPool::get(CardHandle handle) const
+{
+  if (handle >= entries.size()) return nullptr;
+  const Entry &entry = entries[handle];
+  if (entry.type == CardType::Creature) return &creatures[entry.index];
+  return &spells[entry.index];
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Resolves a handle to its creature instance.
+///
+/// @param handle Card handle
+///
+/// @return Pointer to the creature, or nullptr if the handle is empty or a spell
+///
+//---------------------------------------------------------------------------------------------------------------------
+CreatureCard *CardPool::getCreature(CardHandle handle)
+{
+  if (handle >= entries.size() || entries[handle].type != CardType::Creature) return nullptr;
+  if (journal && journal->isRecording()) journal->saveCreature(handle, creatures[entries[handle].index]);
+  return &creatures[entries[handle].index];
+}
+
+const CreatureCard *CardPool::getCreature(CardHandle handle) const
+{
+  if (handle >= entries.size() || entries[handle].type != CardType::Creature) return nullptr;
+  return &creatures[entries[handle].index];
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Frees the newest instances. Handles below count stay valid. The state hash is not updated; the
+/// undo journal and Game::loadState restore it themselves.
+///
+/// @param count Number of instances to keep
+///
+//---------------------------------------------------------------------------------------------------------------------
+void CardPool::truncate(size_t count)
+{
+  while (entries.size() > count)
+  {
+    if (entries.back().type == CardType::Creature) creatures.pop_back();
+    else spells.pop_back();
+    entries.pop_back();
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Points every creature at the state hash and tells it its handle.
+///
+/// @param stateHash Hash of the owning game
+///
+//---------------------------------------------------------------------------------------------------------------------
+void CardPool::bindStateHash(StateHash *stateHash)
+{
+  hash = stateHash;
+  for (size_t handle = 0; handle < entries.size(); ++handle)
+  {
+    if (entries[handle].type == CardType::Creature)
+    {
+      creatures[entries[handle].index].bindStateHash(stateHash, static_cast<CardHandle>(handle));
+    }
+  }
+}
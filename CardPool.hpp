@@ -0,0 +1,137 @@
+// --------------------------- CardPool.hpp ---------------------------
+//
+// Declaration of CardPool: the per-game arena owning every card instance
+// of one game. Cards are addressed by small integer handles, so moving a
+// card between deck, hand, zones and graveyard is a plain handle copy.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "CreatureCard.hpp"
+#include "SpellCard.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Index of a card instance in its game's CardPool. NO_CARD marks an empty slot.
+///
+//---------------------------------------------------------------------------------------------------------------------
+using CardHandle = uint32_t;
+
+constexpr CardHandle NO_CARD = UINT32_MAX;
+constexpr size_t MAX_CARDS = NO_CARD; ///< card instances a game can create (handles 0 to NO_CARD - 1)
+
+class UndoJournal;
+class StateHash;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Owns all card instances of a game. Creatures and spells are stored by value in chunked
+/// storage (std::deque), so instances never move once created and pointers obtained through
+/// get() stay valid until the instance is truncated or the pool destroyed. Handles are never
+/// reused within a game, so a game can create at most MAX_CARDS instances.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class CardPool
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Creates a fresh card instance of a definition.
+  ///
+  /// @param definition Catalog definition of the card (must outlive the pool)
+  ///
+  /// @return Handle of the new card
+  ///
+  /// @throws std::length_error if the game already holds MAX_CARDS instances
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  CardHandle create(const CardDefinition &definition);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Resolves a handle.
+  ///
+  /// @param handle Card handle (NO_CARD allowed)
+  ///
+  /// @return Pointer to the card, nullptr for NO_CARD or an unknown handle
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  Card *get(CardHandle handle);
+
+  const Card *get(CardHandle handle) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Resolves a handle to a creature.
+  ///
+  /// @param handle Card handle (NO_CARD allowed)
+  ///
+  /// @return Pointer to the creature, nullptr if the handle is not a creature
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  CreatureCard *getCreature(CardHandle handle);
+
+  const CreatureCard *getCreature(CardHandle handle) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Destroys the newest card instances until only the given number is left (used to undo actions
+  /// that created cards).
+  ///
+  /// @param count Number of instances to keep
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void truncate(size_t count);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Sets the journal that saves a creature whenever the non-const accessors hand it out, since
+  /// the caller may modify it.
+  ///
+  /// @param undo Journal of the owning game (nullptr for none)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void bindUndoJournal(UndoJournal *undo) { journal = undo; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Binds all creatures, and those created later, to the state hash of the owning game. A new
+  /// card's kind (and a creature's stats) are added to the hash when it is created; truncate()
+  /// leaves the hash alone.
+  ///
+  /// @param stateHash Hash of the owning game (nullptr for none)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void bindStateHash(StateHash *stateHash);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Number of card instances created so far
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  size_t size() const { return entries.size(); }
+
+private:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Location of one instance: its card type selects the storage, index the element in it.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct Entry
+  {
+    CardType type;
+    uint32_t index;
+  };
+
+  std::vector<Entry> entries; // indexed by CardHandle
+  std::deque<CreatureCard> creatures;
+  std::deque<SpellCard> spells;
+  UndoJournal *journal = nullptr; // saves creatures handed out for modification
+  StateHash *hash = nullptr; // hash the creatures keep up to date
+};
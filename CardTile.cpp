@@ -0,0 +1,112 @@
+// --------------------------- CardTile.cpp ---------------------------
+//
+// Implements the CardTileCache.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "CardTile.hpp"
+#include "CreatureCard.hpp"
+#include <sstream>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Packs kind, current attack, current health and traits of a card into 64 bits. Stats are not
+/// truncated: a creature they do not fit has no key.
+///
+/// @param card Card to show
+/// @param key  Receives the cache key
+///
+/// @return false if the creature's stats do not fit 16 bits
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool CardTileCache::keyOf(const Card &card, uint64_t &key)
+{
+  key = static_cast<uint64_t>(card.getKind()) << 48;
+  if (card.getType() != CardType::Creature)
+  {
+    key |= 0xFFFFFFFFFFFFull;
+    return true;
+  }
+  const auto &creature = static_cast<const CreatureCard &>(card);
+  const int attack = creature.getCurrentATK();
+  const int health = creature.getCurrentHP();
+  if (attack < 0 || attack >= 0xFFFF || health < 0 || health >= 0xFFFF)
+  {
+    return false;
+  }
+  key |= static_cast<uint64_t>(attack) << 32 | static_cast<uint64_t>(health) << 16 | creature.getTraits().getBits();
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Looks up the tile of a card and renders it on a miss. Cards without a key, or missing from a
+/// full cache, go to the next scratch tile.
+///
+/// @param card Card to show
+///
+/// @return Reference to the tile
+///
+//---------------------------------------------------------------------------------------------------------------------
+const CardTile &CardTileCache::get(const Card &card)
+{
+  uint64_t key = 0;
+  if (keyOf(card, key))
+  {
+    auto it = tiles.find(key);
+    if (it != tiles.end()) return it->second;
+    if (tiles.size() < MAX_TILES) return render(card, tiles[key]);
+  }
+
+  CardTile &tile = scratch[nextScratch];
+  nextScratch = (nextScratch + 1) % SCRATCH_TILES;
+  return render(card, tile);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Splits the card's printCardDetails output into its non-empty lines and pads them to
+/// TILE_WIDTH.
+///
+/// @param card Card to show
+/// @param tile Tile to overwrite
+///
+/// @return The tile
+///
+//---------------------------------------------------------------------------------------------------------------------
+const CardTile &CardTileCache::render(const Card &card, CardTile &tile)
+{
+  for (string &text: tile) text.clear();
+
+  ostringstream art;
+  card.printCardDetails(art);
+  istringstream lines(art.str());
+  int row = 0;
+  for (string line; row < TILE_ROWS && getline(lines, line);)
+  {
+    if (!line.empty()) tile[row++] = std::move(line);
+  }
+  for (string &text: tile)
+  {
+    if (text.size() < TILE_WIDTH) text.resize(TILE_WIDTH, ' ');
+  }
+  return tile;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the shared tile of an empty slot.
+///
+/// @return Four rows of TILE_WIDTH spaces
+///
+//---------------------------------------------------------------------------------------------------------------------
+const CardTile &CardTileCache::blank()
+{
+  static const CardTile empty = {string(TILE_WIDTH, ' '), string(TILE_WIDTH, ' '),
+                                 string(TILE_WIDTH, ' '), string(TILE_WIDTH, ' ')};
+  return empty;
+}
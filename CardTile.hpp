@@ -0,0 +1,104 @@
+// --------------------------- CardTile.hpp ---------------------------
+//
+// Declares the CardTileCache, which keeps the 4-row ASCII tiles of cards
+// shown on the board so each distinct (kind, ATK, HP, traits) combination
+// is rendered only once.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+class Card;
+
+constexpr int TILE_ROWS = 4; // rows of a card tile
+constexpr int TILE_WIDTH = 9; // minimum width of a tile row
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// The ASCII art of one card, each row left-aligned and padded to TILE_WIDTH characters.
+///
+//---------------------------------------------------------------------------------------------------------------------
+using CardTile = std::array<std::string, TILE_ROWS>;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Cache of rendered card tiles keyed by everything a tile shows: the card kind and, for
+/// creatures, the current attack, health and traits. A card whose visible stats change simply
+/// maps to a different key, so entries never go stale. Copies of a cache start out empty.
+///
+/// The cache holds at most MAX_TILES tiles. Cards beyond that, and creatures whose stats do not
+/// fit the key, are rendered into a small ring of scratch tiles instead.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class CardTileCache
+{
+public:
+  static constexpr size_t MAX_TILES = 4096; ///< cached tiles at most
+  static constexpr size_t SCRATCH_TILES = 7; ///< uncached tiles kept alive, one zone's worth
+
+  CardTileCache() = default;
+  CardTileCache(const CardTileCache &) {}
+  CardTileCache &operator=(const CardTileCache &) { return *this; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Returns the tile of a card, rendering it through printCardDetails on the first request.
+  ///
+  /// @param card Card to show
+  ///
+  /// @return Reference to the tile; valid until the cache is destroyed, or for the next
+  ///         SCRATCH_TILES - 1 calls if the tile could not be cached
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  const CardTile &get(const Card &card);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return The tile of an empty slot (all rows blank)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static const CardTile &blank();
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Number of distinct tiles rendered so far
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  size_t size() const { return tiles.size(); }
+
+private:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Packs the visible state of a card into a cache key.
+  ///
+  /// @param card Card to show
+  /// @param key  Receives kind | ATK | HP | traits, 16 bits each (spells use 0xFFFF for the stats)
+  ///
+  /// @return false if the attack or health of a creature is outside [0, 0xFFFF)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static bool keyOf(const Card &card, uint64_t &key);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Renders a card through printCardDetails into a tile.
+  ///
+  /// @param card Card to show
+  /// @param tile Tile to overwrite
+  ///
+  /// @return The tile
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static const CardTile &render(const Card &card, CardTile &tile);
+
+  std::unordered_map<uint64_t, CardTile> tiles;
+  std::array<CardTile, SCRATCH_TILES> scratch; // uncached tiles, reused round-robin
+  size_t nextScratch = 0;
+};
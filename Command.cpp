@@ -0,0 +1,158 @@
+// --------------------------- Command.cpp ---------------------------
+//
+// Implements the conversion of tokenized command lines into Commands.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "Command.hpp"
+#include "CardCatalog.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+using namespace std;
+
+namespace
+{
+  // Parses F1-F7 / B1-B7, optionally prefixed with O, case-insensitively
+  Slot parseSlot(string_view text, bool allowOpponent)
+  {
+    Slot slot;
+    bool opponent = allowOpponent && text.size() == 3 && toupper(static_cast<unsigned char>(text[0])) == 'O';
+    if (opponent) text.remove_prefix(1);
+    if (text.size() != 2 || text[1] < '1' || text[1] > '7') return slot;
+    char zone = static_cast<char>(toupper(static_cast<unsigned char>(text[0])));
+    if (zone != 'F' && zone != 'B') return slot;
+    slot.zone = (zone == 'F') ? SlotZone::Field : SlotZone::Battle;
+    slot.opponent = opponent;
+    slot.index = static_cast<int8_t>(text[1] - '1');
+    return slot;
+  }
+
+  // Appends " F1" / " OB3" etc.
+  void appendSlot(string &line, const Slot &slot)
+  {
+    line += ' ';
+    if (slot.opponent) line += 'O';
+    line += (slot.zone == SlotZone::Battle) ? 'B' : 'F';
+    line += static_cast<char>('1' + slot.index);
+  }
+
+  // Resolves a card ID given in any case
+  CardKind findCardKind(const CardCatalog &catalog, string_view text)
+  {
+    string id(text); // card IDs fit the small-string buffer
+    transform(id.begin(), id.end(), id.begin(), ::toupper);
+    return catalog.findKind(id);
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Converts a tokenized action into a Command, checking parameter counts, card IDs and slot names
+/// in the order the game reports them.
+///
+/// @param tokens  Tokenized command line
+/// @param catalog Card definitions used to resolve card IDs
+/// @param command Receives the command
+///
+/// @return Ok, or the status of the first error found in the text
+///
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus parseCommand(const TokenizedCommand &tokens, const CardCatalog &catalog, Command &command)
+{
+  command = Command();
+  command.verb = tokens.verb;
+  switch (tokens.verb)
+  {
+    case Verb::Done:
+    case Verb::Redraw:
+      return (tokens.argCount == 0) ? CommandStatus::Ok : CommandStatus::InvalidParamCount;
+
+    case Verb::Creature:
+      if (tokens.argCount != 2) return CommandStatus::InvalidParamCount;
+      command.card = findCardKind(catalog, tokens.args[0]);
+      if (command.card == NO_CARD_KIND) return CommandStatus::InvalidCard;
+      command.source = parseSlot(tokens.args[1], false);
+      if (command.source.zone == SlotZone::None) return CommandStatus::InvalidSlot;
+      return CommandStatus::Ok;
+
+    case Verb::Battle:
+      if (tokens.argCount != 2) return CommandStatus::InvalidParamCount;
+      command.source = parseSlot(tokens.args[0], false);
+      command.target = parseSlot(tokens.args[1], false);
+      if (command.source.zone == SlotZone::None || command.target.zone == SlotZone::None)
+      {
+        return CommandStatus::InvalidSlot;
+      }
+      return CommandStatus::Ok;
+
+    case Verb::Spell:
+    {
+      if (tokens.argCount < 1) return CommandStatus::MissingCard;
+      command.card = findCardKind(catalog, tokens.args[0]);
+      if (command.card == NO_CARD_KIND) return CommandStatus::InvalidCard;
+      command.targetCount = static_cast<uint8_t>(min<size_t>(tokens.argCount - 1, UINT8_MAX));
+      const CardDefinition &definition = catalog.get(command.card);
+      if (command.targetCount > 0 && definition.type == CardType::Spell)
+      {
+        if (definition.spellType == SpellType::Target)
+        {
+          command.target = parseSlot(tokens.args[1], true);
+        }
+        else if (definition.spellType == SpellType::Graveyard)
+        {
+          command.graveyardTarget = catalog.findKind(string(tokens.args[1])); // matched case-insensitively
+        }
+      }
+      return CommandStatus::Ok;
+    }
+
+    default:
+      return CommandStatus::UnknownCommand;
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Formats a Command as a command line; the inverse of parseCommand for valid commands.
+///
+/// @param command Command to format
+/// @param catalog Card definitions used to name the cards
+///
+/// @return The command line
+///
+//---------------------------------------------------------------------------------------------------------------------
+string formatCommand(const Command &command, const CardCatalog &catalog)
+{
+  string line;
+  switch (command.verb)
+  {
+    case Verb::Done: return "done";
+    case Verb::Redraw: return "redraw";
+    case Verb::Creature:
+      line = "creature " + catalog.get(command.card).id;
+      appendSlot(line, command.source);
+      return line;
+    case Verb::Battle:
+      line = "battle";
+      appendSlot(line, command.source);
+      appendSlot(line, command.target);
+      return line;
+    case Verb::Spell:
+      line = "spell " + catalog.get(command.card).id;
+      if (command.graveyardTarget != NO_CARD_KIND)
+      {
+        line += ' ' + catalog.get(command.graveyardTarget).id;
+      }
+      else if (command.target.zone != SlotZone::None)
+      {
+        appendSlot(line, command.target);
+      }
+      return line;
+    default:
+      return line;
+  }
+}
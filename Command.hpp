@@ -0,0 +1,122 @@
+// --------------------------- Command.hpp ---------------------------
+//
+// Declares the typed command representation the engine executes through
+// Game::apply, the status codes it returns and the conversion from a
+// tokenized command line.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "CardDefinition.hpp"
+#include "CommandTokenizer.hpp"
+
+class CardCatalog;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Outcome of a command. Every value except Ok corresponds to one E_* message.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class CommandStatus : uint8_t
+{
+  Ok,
+  UnknownCommand,
+  InvalidParamCount,
+  MissingCard,
+  InvalidCard,
+  InvalidSlot,
+  RedrawDisabled,
+  RedrawNotEnoughCards,
+  NotInHand,
+  NotCreature,
+  NotSpell,
+  InvalidParamCountSpell,
+  NotInField,
+  FieldEmpty,
+  CreatureCannotBattle,
+  NotInBattle,
+  BattleOccupied,
+  FieldOccupied,
+  InvalidSlotSpell,
+  TargetEmpty,
+  NotInGraveyard,
+  NotEnoughMana
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Zone a slot refers to.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class SlotZone : uint8_t
+{
+  None,
+  Field,
+  Battle
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// A board slot as named in commands (F1-F7, B1-B7, prefixed with O for the opponent's side).
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct Slot
+{
+  SlotZone zone = SlotZone::None; ///< None if no (valid) slot was given
+  bool opponent = false; ///< slot on the opponent's side (target spells only)
+  int8_t index = -1; ///< 0-based slot index
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Binary form of a game action, executed by Game::apply without any string handling.
+///
+///  - Done, Redraw: no operands
+///  - Creature: card from hand, source = field slot to place it in
+///  - Battle: source = field slot of the creature, target = battle slot
+///  - Spell: card from hand; targetCount parameters follow it, which are either the target slot
+///    (target spells; zone None if the parameter was no slot) or graveyardTarget (graveyard spells)
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct Command
+{
+  Verb verb = Verb::Unknown; ///< action to perform
+  CardKind card = NO_CARD_KIND; ///< card played from hand
+  Slot source; ///< slot the action starts from
+  Slot target; ///< slot the action is aimed at
+  CardKind graveyardTarget = NO_CARD_KIND; ///< card chosen from the graveyard
+  uint8_t targetCount = 0; ///< number of spell parameters after the card (saturates at 255)
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Converts a tokenized action (done, redraw, creature, battle, spell) into a Command. Only errors
+/// that can be told from the text alone are reported here; everything depending on the game
+/// state is left to Game::apply, so the errors keep their order.
+///
+/// @param tokens  Tokenized command line
+/// @param catalog Card definitions used to resolve card IDs
+/// @param command Receives the command
+///
+/// @return Ok, or the status of the first error found in the text
+///
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus parseCommand(const TokenizedCommand &tokens, const CardCatalog &catalog, Command &command);
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Writes a Command back as the command line that parses to it (e.g. "spell CURSE OF1"), so tools
+/// can print moves in the same form a player types them.
+///
+/// @param command Command to format (Done, Redraw, Creature, Battle or Spell)
+/// @param catalog Card definitions used to name the cards
+///
+/// @return The command line
+///
+//---------------------------------------------------------------------------------------------------------------------
+std::string formatCommand(const Command &command, const CardCatalog &catalog);
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <string>
+#include "CommandTokenizer.hpp"
 #include "Game.hpp"
 
 // -------------------------------------------------------------
@@ -33,29 +34,23 @@ public:
   static bool process(const std::string &input, Game &game);
 
 private:
-  static bool handleQuit(const std::string &input, Game &game);
+  static bool handleQuit(const TokenizedCommand &command, Game &game);
 
-  static bool handleDone(const std::string &input, Game &game);
+  static bool handleAction(const TokenizedCommand &tokens, Game &game);
 
-  static bool handleInfo(const std::string &input, Game &game);
+  static bool handleInfo(const TokenizedCommand &command, Game &game);
 
-  static bool handleHelp(const std::string &input, Game &game);
+  static bool handleHelp(const TokenizedCommand &command, Game &game);
 
-  static bool handleBoard(const std::string &input, Game &game);
+  static bool handleBoard(const TokenizedCommand &command, Game &game);
 
-  static bool handleStatus(const std::string &input, Game &game);
+  static bool handleStatus(const TokenizedCommand &command, Game &game);
 
-  static bool handleGraveyard(const std::string &input, Game &game);
+  static bool handleGraveyard(const TokenizedCommand &command, Game &game);
 
-  static bool handleCreature(const std::string &input, Game &game);
+  static bool handleHand(const TokenizedCommand &command, Game &game);
 
-  static bool handleBattle(const std::string &input, Game &game);
+  static bool handlePreview(const TokenizedCommand &command, Game &game);
 
-  static bool handleHand(const std::string &input, Game &game);
-
-  static bool handleRedraw(const std::string &input, Game &game);
-
-  static bool handleSpell(const std::string &input, Game &game);
-
-  static bool printUnknownCommand(const std::string &input, Game &game);
+  static bool printUnknownCommand(Game &game);
 };
@@ -0,0 +1,182 @@
+// --------------------------- CommandSource.cpp ---------------------------
+//
+// Implements the stream-backed and scripted command sources that feed
+// command lines into a Game.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "CommandSource.hpp"
+#include "Game.hpp"
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Constructs a source reading from the given stream.
+///
+/// @param in Stream the command lines are read from
+///
+//---------------------------------------------------------------------------------------------------------------------
+StreamCommandSource::StreamCommandSource(istream &in)
+  : in(in)
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Reads the next line from the stream.
+///
+/// @param command Receives the line
+///
+/// @return false on EOF
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool StreamCommandSource::nextCommand(const Game & /*game*/, string &command)
+{
+  return static_cast<bool>(getline(in, command));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Constructs a scripted source over the given command lines.
+///
+/// @param lines Command lines in the order they are issued
+/// @param loop  Restart from the first line after the last one
+///
+//---------------------------------------------------------------------------------------------------------------------
+ScriptedCommandSource::ScriptedCommandSource(const vector<string> &lines, bool loop)
+  : lines(lines)
+    , loop(loop)
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Hands out the next script line, wrapping around if looping is enabled.
+///
+/// @param command Receives the line
+///
+/// @return false once a non-looping script is exhausted (or the script is empty)
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool ScriptedCommandSource::nextCommand(const Game & /*game*/, string &command)
+{
+  if (position == lines.size())
+  {
+    if (!loop || lines.empty()) return false;
+    position = 0;
+  }
+  command = lines[position++];
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Loads a command script from disk. Empty lines and '#' comments are skipped.
+///
+/// @param path Path to the script file
+///
+/// @return The command lines of the script
+///
+//---------------------------------------------------------------------------------------------------------------------
+vector<string> ScriptedCommandSource::loadScript(const string &path)
+{
+  ifstream in(path);
+  if (!in.is_open())
+  {
+    throw runtime_error("Could not open command script: " + path);
+  }
+
+  vector<string> lines;
+  string line;
+  while (getline(in, line))
+  {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty() || line[0] == '#') continue;
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Looks for a line that ends the turn.
+///
+/// @param lines Command lines of the script
+///
+/// @return true if a line starts with "done"
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool ScriptedCommandSource::endsTurn(const vector<string> &lines)
+{
+  for (const string &line: lines)
+  {
+    if (line.rfind("done", 0) == 0) return true;
+  }
+  return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Constructs a source that asks the source of the current player's seat.
+///
+/// @param player1 Source of player 1's commands
+/// @param player2 Source of player 2's commands
+///
+//---------------------------------------------------------------------------------------------------------------------
+SeatedCommandSource::SeatedCommandSource(CommandSource &player1, CommandSource &player2)
+  : seats{&player1, &player2}
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Forwards to the source of the player whose turn it is and echoes the command if requested.
+///
+/// @param game    Game asking for a command
+/// @param command Receives the command line
+///
+/// @return false if that seat's source is exhausted
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool SeatedCommandSource::nextCommand(const Game &game, string &command)
+{
+  int seat = (game.getCurrentPlayer().getId() == 2) ? 1 : 0;
+  if (!seats[seat]->nextCommand(game, command)) return false;
+  if (echoes[seat])
+  {
+    *echoes[seat] << command << "\n";
+    echoes[seat]->flush();
+  }
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Resets both seats.
+///
+//---------------------------------------------------------------------------------------------------------------------
+void SeatedCommandSource::reset()
+{
+  seats[0]->reset();
+  seats[1]->reset();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Sets or clears the echo stream of a seat.
+///
+/// @param playerId Seat (1 or 2)
+/// @param echo     Stream to echo to, or nullptr
+///
+//---------------------------------------------------------------------------------------------------------------------
+void SeatedCommandSource::setEcho(int playerId, ostream *echo)
+{
+  echoes[(playerId == 2) ? 1 : 0] = echo;
+}
@@ -0,0 +1,161 @@
+// --------------------------- CommandSource.hpp ---------------------------
+//
+// Declares the CommandSource interface, which supplies the command lines
+// a Game processes, together with an interactive stream-backed source and
+// a scripted source used for headless batch simulation.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class Game;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Abstract supplier of player commands. The game asks its source for the next command line
+/// whenever the current player has to act, so a terminal, a script or a bot can drive a game.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class CommandSource
+{
+public:
+  virtual ~CommandSource() = default;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Produces the next command for the current player.
+  ///
+  /// @param game    Game asking for a command (read access for bots)
+  /// @param command Receives the raw command line
+  ///
+  /// @return false if the source is exhausted (treated like EOF)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  virtual bool nextCommand(const Game &game, std::string &command) = 0;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Prepares the source for a new game. Sources without per-game state ignore this.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  virtual void reset() {}
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Reads one command per line from an input stream (std::cin for interactive play).
+///
+//---------------------------------------------------------------------------------------------------------------------
+class StreamCommandSource : public CommandSource
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param in Stream the command lines are read from
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  explicit StreamCommandSource(std::istream &in);
+
+  bool nextCommand(const Game &game, std::string &command) override;
+
+private:
+  std::istream &in;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Replays a fixed list of command lines. When looping is enabled the script starts over once it
+/// is exhausted, so a short script (that contains "done") can drive a game until it ends.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class ScriptedCommandSource : public CommandSource
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param lines Command lines in the order they are issued (must outlive the source)
+  /// @param loop  Restart from the first line after the last one
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  ScriptedCommandSource(const std::vector<std::string> &lines, bool loop);
+
+  bool nextCommand(const Game &game, std::string &command) override;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Rewinds the script to its first line so the source can drive another game.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void reset() override { position = 0; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Loads a script file, skipping empty lines and lines starting with '#'.
+  ///
+  /// @param path Path to the script file
+  ///
+  /// @return The command lines of the script
+  ///
+  /// @throws std::runtime_error if the file cannot be opened
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static std::vector<std::string> loadScript(const std::string &path);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Checks that a looping script can make progress: without a "done" command no turn ever ends.
+  ///
+  /// @param lines Command lines of the script
+  ///
+  /// @return true if a line starts with "done"
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static bool endsTurn(const std::vector<std::string> &lines);
+
+private:
+  const std::vector<std::string> &lines;
+  bool loop;
+  size_t position = 0;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Gives each seat its own source, e.g. a human on the terminal against a bot. Commands of a seat
+/// can be echoed, so a bot's moves show up after the prompt like typed ones.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class SeatedCommandSource : public CommandSource
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param player1 Source of player 1's commands (must outlive this source)
+  /// @param player2 Source of player 2's commands (must outlive this source)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  SeatedCommandSource(CommandSource &player1, CommandSource &player2);
+
+  bool nextCommand(const Game &game, std::string &command) override;
+
+  void reset() override;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Echoes the commands of one seat, followed by a newline.
+  ///
+  /// @param playerId Seat (1 or 2)
+  /// @param echo     Stream to echo to, or nullptr to stop echoing
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void setEcho(int playerId, std::ostream *echo);
+
+private:
+  CommandSource *seats[2];
+  std::ostream *echoes[2] = {nullptr, nullptr};
+};
@@ -0,0 +1,173 @@
+// --------------------------- CommandTokenizer.cpp ---------------------------
+//
+// Implements the command tokenizer and its compile-time verb hash.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "CommandTokenizer.hpp"
+
+using namespace std;
+
+namespace
+{
+  // How the arguments of a verb are separated
+  enum class ArgStyle : uint8_t
+  {
+    None, // no parameters; the text after the verb must be blank
+    Words, // whitespace separated words
+    Spaces // single-space separated words
+  };
+
+  struct VerbInfo
+  {
+    string_view name;
+    Verb verb;
+    ArgStyle style;
+  };
+
+  constexpr array<VerbInfo, 13> VERBS = {
+    {
+      {"quit", Verb::Quit, ArgStyle::None},
+      {"done", Verb::Done, ArgStyle::None},
+      {"info", Verb::Info, ArgStyle::Words},
+      {"help", Verb::Help, ArgStyle::None},
+      {"board", Verb::Board, ArgStyle::None},
+      {"status", Verb::Status, ArgStyle::None},
+      {"graveyard", Verb::Graveyard, ArgStyle::None},
+      {"creature", Verb::Creature, ArgStyle::Spaces},
+      {"battle", Verb::Battle, ArgStyle::Words},
+      {"hand", Verb::Hand, ArgStyle::None},
+      {"redraw", Verb::Redraw, ArgStyle::None},
+      {"spell", Verb::Spell, ArgStyle::Words},
+      {"preview", Verb::Preview, ArgStyle::None}
+    }
+  };
+
+  constexpr string_view BLANK = " \t\r\n"; // trimmed around the line
+  constexpr string_view WHITESPACE = " \t\n\v\f\r"; // separates words
+
+  constexpr char toLower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c; }
+
+  // Packs the first four characters (lowercased) into one integer
+  constexpr uint32_t packPrefix(string_view text)
+  {
+    uint32_t packed = 0;
+    for (size_t i = 0; i < 4; ++i)
+    {
+      packed |= static_cast<uint32_t>(static_cast<unsigned char>(toLower(text[i]))) << (8 * i);
+    }
+    return packed;
+  }
+
+  constexpr int HASH_BITS = 5;
+  constexpr size_t HASH_SIZE = size_t{1} << HASH_BITS;
+
+  constexpr size_t hashPrefix(uint32_t packed, uint32_t multiplier)
+  {
+    return (packed * multiplier) >> (32 - HASH_BITS);
+  }
+
+  // Smallest multiplier (from a fixed odd seed) that maps the prefixes of all verbs to distinct slots
+  constexpr uint32_t findMultiplier()
+  {
+    for (uint32_t multiplier = 0x9E3779B1u;; multiplier += 2)
+    {
+      array<bool, HASH_SIZE> used{};
+      bool collision = false;
+      for (const VerbInfo &info: VERBS)
+      {
+        size_t slot = hashPrefix(packPrefix(info.name), multiplier);
+        collision = collision || used[slot];
+        used[slot] = true;
+      }
+      if (!collision) return multiplier;
+    }
+  }
+
+  constexpr uint32_t MULTIPLIER = findMultiplier();
+
+  // Slot -> index into VERBS, or VERBS.size() for an empty slot
+  constexpr array<uint8_t, HASH_SIZE> buildTable()
+  {
+    array<uint8_t, HASH_SIZE> table{};
+    table.fill(static_cast<uint8_t>(VERBS.size()));
+    for (size_t i = 0; i < VERBS.size(); ++i)
+    {
+      table[hashPrefix(packPrefix(VERBS[i].name), MULTIPLIER)] = static_cast<uint8_t>(i);
+    }
+    return table;
+  }
+
+  constexpr array<uint8_t, HASH_SIZE> VERB_TABLE = buildTable();
+
+  // Finds the verb the line starts with; every verb has at least four characters
+  const VerbInfo *matchVerb(string_view line)
+  {
+    if (line.size() < 4) return nullptr;
+    uint8_t index = VERB_TABLE[hashPrefix(packPrefix(line), MULTIPLIER)];
+    if (index >= VERBS.size()) return nullptr;
+    const VerbInfo &info = VERBS[index];
+    if (line.size() < info.name.size()) return nullptr;
+    for (size_t i = 0; i < info.name.size(); ++i)
+    {
+      if (toLower(line[i]) != info.name[i]) return nullptr; // the hash only narrows it down
+    }
+    return &info;
+  }
+
+  // Splits text at any of the delimiters, optionally dropping the first word, and stores the words
+  void splitArguments(TokenizedCommand &command, string_view text, string_view delimiters, bool skipFirst)
+  {
+    size_t pos = text.find_first_not_of(delimiters);
+    while (pos != string_view::npos)
+    {
+      size_t end = text.find_first_of(delimiters, pos);
+      string_view word = text.substr(pos, end == string_view::npos ? string_view::npos : end - pos);
+      if (skipFirst)
+      {
+        skipFirst = false;
+      }
+      else
+      {
+        if (command.argCount < MAX_COMMAND_ARGS) command.args[command.argCount] = word;
+        command.argCount++;
+      }
+      pos = (end == string_view::npos) ? end : text.find_first_not_of(delimiters, end);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Trims the line, finds its verb through the perfect hash and splits the arguments according
+/// to the verb's style.
+///
+/// @param line Raw command line
+///
+/// @return The tokenized command
+///
+//---------------------------------------------------------------------------------------------------------------------
+TokenizedCommand tokenizeCommand(string_view line)
+{
+  TokenizedCommand command;
+  size_t first = line.find_first_not_of(BLANK);
+  if (first == string_view::npos) return command;
+  line = line.substr(first, line.find_last_not_of(BLANK) + 1 - first);
+
+  const VerbInfo *info = matchVerb(line);
+  if (!info) return command;
+  command.verb = info->verb;
+
+  switch (info->style)
+  {
+    case ArgStyle::None: splitArguments(command, line.substr(info->name.size()), BLANK, false);
+      break;
+    case ArgStyle::Words: splitArguments(command, line, WHITESPACE, true);
+      break;
+    case ArgStyle::Spaces: splitArguments(command, line, " ", true);
+      break;
+  }
+  return command;
+}
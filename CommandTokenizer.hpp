@@ -0,0 +1,70 @@
+// --------------------------- CommandTokenizer.hpp ---------------------------
+//
+// Declares the single-pass command tokenizer. A command line is split into
+// a fixed-size record of string_views (no allocation) and its verb is found
+// through a perfect hash over the first four characters.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Command verbs understood by the game.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class Verb : uint8_t
+{
+  Quit,
+  Done,
+  Info,
+  Help,
+  Board,
+  Status,
+  Graveyard,
+  Creature,
+  Battle,
+  Hand,
+  Redraw,
+  Spell,
+  Preview,
+  Unknown
+};
+
+constexpr size_t MAX_COMMAND_ARGS = 2; // arguments kept by a TokenizedCommand
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// A command line split into its verb and arguments. The views point into the line that was
+/// tokenized, which has to outlive the record.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct TokenizedCommand
+{
+  Verb verb = Verb::Unknown; ///< verb matched at the start of the line
+  size_t argCount = 0; ///< number of arguments after the verb (may exceed MAX_COMMAND_ARGS)
+  std::array<std::string_view, MAX_COMMAND_ARGS> args; ///< the first arguments
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Tokenizes one command line. Surrounding spaces, tabs and line breaks are ignored and the verb
+/// is matched case-insensitively as a prefix of the line. Arguments are split the way each
+/// command has always read them:
+///  - commands without parameters count anything after the verb as arguments
+///  - "creature" separates its arguments by single spaces only
+///  - all other commands split the whole line at whitespace and drop the first word
+///
+/// @param line Raw command line
+///
+/// @return The tokenized command (verb Unknown if no verb matches)
+///
+//---------------------------------------------------------------------------------------------------------------------
+TokenizedCommand tokenizeCommand(std::string_view line);
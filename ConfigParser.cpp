@@ -51,6 +51,20 @@ int GameConfigParser::getManaPoolStart() const { return manaPoolStart; }
 const vector<string> &GameConfigParser::getPlayer1Deck() const { return deck1; }
 const vector<string> &GameConfigParser::getPlayer2Deck() const { return deck2; }
 
+// ------------------------------------------------------------------------
+//
+// Replaces both decks (used to play tournament matchups).
+//
+// @param player1Deck Card IDs of Player 1's deck
+// @param player2Deck Card IDs of Player 2's deck
+//
+// ------------------------------------------------------------------------
+void GameConfigParser::setDecks(const vector<string> &player1Deck, const vector<string> &player2Deck)
+{
+  deck1 = player1Deck;
+  deck2 = player2Deck;
+}
+
 // ------------------------------------------------------------------------
 //
 // Parses the game configuration file step by step. Verifies magic header,
@@ -121,7 +135,7 @@ void GameConfigParser::parseFile(const string &filePath)
 // @return Vector of card ID strings
 //
 // ------------------------------------------------------------------------
-vector<string> GameConfigParser::splitIds(const string &line) const
+vector<string> GameConfigParser::splitIds(const string &line)
 {
   vector<string> ids;
   string token;
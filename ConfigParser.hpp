@@ -54,6 +54,28 @@ public:
 
   const std::vector<std::string> &getPlayer2Deck() const;
 
+  // -------------------------------------------------------------
+  //
+  // Replaces both decks, e.g. to play a tournament matchup with
+  // the constants of this config. The decks are not size-checked.
+  //
+  // @param player1Deck Card IDs of Player 1's deck
+  // @param player2Deck Card IDs of Player 2's deck
+  //
+  // -------------------------------------------------------------
+  void setDecks(const std::vector<std::string> &player1Deck,
+                const std::vector<std::string> &player2Deck);
+
+  // -------------------------------------------------------------
+  //
+  // Helper function to split semicolon-separated card IDs.
+  //
+  // @param line Line from config file (e.g. "ID1;ID2;ID3")
+  // @return Vector of extracted card IDs
+  //
+  // -------------------------------------------------------------
+  static std::vector<std::string> splitIds(const std::string &line);
+
 private:
   int playerHealth;
   int maxRounds;
@@ -71,14 +93,4 @@ private:
   //
   // -------------------------------------------------------------
   void parseFile(const std::string &filePath);
-
-  // -------------------------------------------------------------
-  //
-  // Helper function to split semicolon-separated card IDs.
-  //
-  // @param line Line from config file (e.g. "ID1;ID2;ID3")
-  // @return Vector of extracted card IDs
-  //
-  // -------------------------------------------------------------
-  std::vector<std::string> splitIds(const std::string &line) const;
 };
@@ -2,7 +2,7 @@
 //
 // This file defines the CreatureCard class, which extends the base Card
 // and models creatures with health, attack, and traits such as Haste,
-// Lifesteal, Undying, etc. Also includes the Trait enum and related helpers.
+// Lifesteal, Undying, etc. Static data lives in the shared CardDefinition.
 //
 // Group: 051
 //
@@ -12,6 +12,9 @@
 #define CREATURECARD_HPP
 
 #include "Card.hpp"
+#include "GameState.hpp"
+#include "StateHash.hpp"
+#include "Trait.hpp"
 #include <vector>
 #include <algorithm>
 #include <iostream>
@@ -19,156 +22,116 @@
 
 using namespace std; // bring in std symbols for clarity
 
-//-----------------------------------------------------------------------------
-// Trait: flags indicating special abilities or statuses for creature cards
-//-----------------------------------------------------------------------------
-enum class Trait
-{
-  Brutal, ///< deals extra damage
-  Challenger, ///< forces blocks
-  FirstStrike, ///< attacks before defenders
-  Haste, ///< can attack immediately
-  Lifesteal, ///< heals controller on damage
-  Poisoned, ///< applies poison effect
-  Regenerate, ///< recovers health after destruction
-  Temporary, ///< limited-duration buffs
-  Undying, ///< returns with 1 HP when destroyed
-  Venomous ///< applies poison on attack
-};
-
-// -------------------------------------------------------------
-// Converts a Trait enum value into a full string name.
-// -------------------------------------------------------------
-inline std::string traitToString(Trait t)
-{
-  switch (t)
-  {
-    case Trait::Brutal: return "Brutal";
-    case Trait::Challenger: return "Challenger";
-    case Trait::FirstStrike: return "First Strike";
-    case Trait::Haste: return "Haste";
-    case Trait::Lifesteal: return "Lifesteal";
-    case Trait::Poisoned: return "Poisoned";
-    case Trait::Regenerate: return "Regenerate";
-    case Trait::Temporary: return "Temporary";
-    case Trait::Undying: return "Undying";
-    case Trait::Venomous: return "Venomous";
-    default: return "";
-  }
-}
-
 // -------------------------------------------------------------
 // CreatureCard: represents a creature card with traits, attack, and health
 // -------------------------------------------------------------
 class CreatureCard : public Card
 {
 protected:
-  int baseATK;
-  int baseHP;
+  // Only the mutable per-instance state lives here; base stats and
+  // base traits are read from the shared definition.
   int curATK;
   int curHP;
-  vector<Trait> baseTraits;
-  vector<Trait> traits;
   int summonedRound;
-  int lastFieldIndex = -1;
-  int lastFieldOwner = -1;
+  TraitSet traits;
+  int8_t lastFieldIndex = -1;
+  int8_t lastFieldOwner = -1;
   bool resurrected = false;
+  StateHash *hash = nullptr; // hash of the owning game, updated on every change
+  uint32_t handle = 0; // handle of this card in its pool (the subject of its hash facts)
+
+  // Stat setters that keep the hash up to date
+  void assignAttack(int value)
+  {
+    if (hash) hash->change(HashFeature::Attack, handle, static_cast<uint32_t>(curATK), static_cast<uint32_t>(value));
+    curATK = value;
+  }
+
+  void assignHealth(int value)
+  {
+    if (hash) hash->change(HashFeature::Health, handle, static_cast<uint32_t>(curHP), static_cast<uint32_t>(value));
+    curHP = value;
+  }
+
+  void assignTraits(TraitSet value)
+  {
+    if (hash) hash->change(HashFeature::Traits, handle, traits.getBits(), value.getBits());
+    traits = value;
+  }
+
+  uint64_t lastFieldValue() const
+  {
+    return static_cast<uint8_t>(lastFieldIndex) | (static_cast<uint64_t>(static_cast<uint8_t>(lastFieldOwner)) << 8);
+  }
 
 public:
   // -------------------------------------------------------------
   //
-  // Constructor for a CreatureCard.
+  // Constructor for a CreatureCard with base stats and traits.
   //
-  // @param id          Card ID
-  // @param name        Card name
-  // @param manaCost    Mana cost
-  // @param baseATK     Base attack value
-  // @param baseHP      Base health value
-  // @param baseTraits  Initial traits for the creature
+  // @param definition  Creature definition from the CardCatalog
   //
   // -------------------------------------------------------------
-  CreatureCard(
-    const string &id,
-    const string &name,
-    int manaCost,
-    int baseATK,
-    int baseHP,
-    const vector<Trait> &baseTraits
-  )
-    : Card(id, name, manaCost, CardType::Creature)
-      , baseATK(baseATK)
-      , baseHP(baseHP)
-      , curATK(baseATK)
-      , curHP(baseHP)
-      , baseTraits(baseTraits)
-      , traits(baseTraits)
+  explicit CreatureCard(const CardDefinition &definition)
+    : Card(definition)
+      , curATK(definition.baseATK)
+      , curHP(definition.baseHP)
       , summonedRound(-1)
+      , traits(definition.baseTraits)
   {
   }
 
   // --------------------------------------------------------------------------
-  // Removes all instances of the given trait from the creature.
+  // Removes the given trait from the creature.
   //
-  // @param trait The trait to remove from the current traits list
+  // @param trait The trait to remove from the current traits
   // --------------------------------------------------------------------------
   void removeTrait(Trait trait)
   {
-    traits.erase(std::remove(traits.begin(), traits.end(), trait), traits.end());
+    TraitSet changed = traits;
+    changed.remove(trait);
+    assignTraits(changed);
   }
 
-  // Returns sorted single-letter trait code string (max 5 letters; 5th is '+' if overflow)
-  string getTraitsString() const
+  // --------------------------------------------------------------------------
+  // Binds the creature to the state hash of its game.
+  // @param stateHash  Hash to update on every change (nullptr for none)
+  // @param cardHandle Handle of this creature in the game's pool
+  // --------------------------------------------------------------------------
+  void bindStateHash(StateHash *stateHash, uint32_t cardHandle)
   {
-    vector<char> traitLetters;
-    for (Trait t: traits)
-    {
-      switch (t)
-      {
-        case Trait::Brutal: traitLetters.push_back('B');
-          break;
-        case Trait::Challenger: traitLetters.push_back('C');
-          break;
-        case Trait::FirstStrike: traitLetters.push_back('F');
-          break;
-        case Trait::Haste: traitLetters.push_back('H');
-          break;
-        case Trait::Lifesteal: traitLetters.push_back('L');
-          break;
-        case Trait::Poisoned: traitLetters.push_back('P');
-          break;
-        case Trait::Regenerate: traitLetters.push_back('R');
-          break;
-        case Trait::Temporary: traitLetters.push_back('T');
-          break;
-        case Trait::Undying: traitLetters.push_back('U');
-          break;
-        case Trait::Venomous: traitLetters.push_back('V');
-          break;
-      }
-    }
-
-    sort(traitLetters.begin(), traitLetters.end());
+    hash = stateHash;
+    handle = cardHandle;
+  }
 
-    string result;
-    for (size_t i = 0; i < min<size_t>(5, traitLetters.size()); ++i)
-    {
-      result += traitLetters[i];
-    }
-    if (traitLetters.size() > 5)
-    {
-      result[4] = '+';
-    }
+  // --------------------------------------------------------------------------
+  // Toggles all stat facts of this creature in a hash (adds them to a hash
+  // being built, or removes them).
+  // @param target Hash to update
+  // --------------------------------------------------------------------------
+  void hashStats(StateHash &target) const
+  {
+    target.toggle(HashFeature::Attack, handle, static_cast<uint32_t>(curATK));
+    target.toggle(HashFeature::Health, handle, static_cast<uint32_t>(curHP));
+    target.toggle(HashFeature::SummonedRound, handle, static_cast<uint32_t>(summonedRound));
+    target.toggle(HashFeature::Traits, handle, traits.getBits());
+    target.toggle(HashFeature::LastField, handle, lastFieldValue());
+    if (resurrected) target.toggle(HashFeature::Resurrected, handle, 0);
+  }
 
-    return result;
+  // Returns sorted single-letter trait code string (max 5 letters; 5th is '+' if overflow)
+  string getTraitsString() const
+  {
+    return string(traitCode(traits));
   }
 
-  const std::vector<Trait> &getBaseTraits() const
+  TraitSet getBaseTraits() const
   {
-    return baseTraits;
+    return definition->baseTraits;
   }
 
 
-  const std::vector<Trait> &getTraits() const
+  TraitSet getTraits() const
   {
     return traits;
   }
@@ -180,7 +143,48 @@ public:
   // --------------------------------------------------------------------------
   void setLastFieldIndex(int index)
   {
-    lastFieldIndex = index;
+    uint64_t old = lastFieldValue();
+    lastFieldIndex = static_cast<int8_t>(index);
+    if (hash) hash->change(HashFeature::LastField, handle, old, lastFieldValue());
+  }
+
+  // --------------------------------------------------------------------------
+  // Copies the per-instance state into a GameState entry.
+  //
+  // @param state Entry to fill (kind is left to the caller)
+  // @return false if a stat does not fit the snapshot
+  // --------------------------------------------------------------------------
+  bool saveState(CardState &state) const
+  {
+    if (curATK < INT16_MIN || curATK > INT16_MAX || curHP < INT16_MIN || curHP > INT16_MAX)
+    {
+      return false;
+    }
+    state.attack = static_cast<int16_t>(curATK);
+    state.health = static_cast<int16_t>(curHP);
+    state.summonedRound = summonedRound;
+    state.traits = traits;
+    state.lastFieldIndex = lastFieldIndex;
+    state.lastFieldOwner = lastFieldOwner;
+    state.resurrected = resurrected;
+    return true;
+  }
+
+  // --------------------------------------------------------------------------
+  // Restores the per-instance state from a GameState entry. The hash is
+  // not updated; the game recomputes it after loading a state.
+  //
+  // @param state Entry written by saveState
+  // --------------------------------------------------------------------------
+  void loadState(const CardState &state)
+  {
+    curATK = state.attack;
+    curHP = state.health;
+    summonedRound = state.summonedRound;
+    traits = state.traits;
+    lastFieldIndex = state.lastFieldIndex;
+    lastFieldOwner = state.lastFieldOwner;
+    resurrected = state.resurrected;
   }
 
   // --------------------------------------------------------------------------
@@ -193,7 +197,11 @@ public:
   // --------------------------------------------------------------------------
   // Marks the creature as resurrected (typically by Undying).
   // --------------------------------------------------------------------------
-  void markResurrected() { resurrected = true; }
+  void markResurrected()
+  {
+    if (hash && !resurrected) hash->toggle(HashFeature::Resurrected, handle, 0);
+    resurrected = true;
+  }
 
   // --------------------------------------------------------------------------
   // Gets the index of the last field slot the creature occupied.
@@ -212,7 +220,9 @@ public:
   // --------------------------------------------------------------------------
   void setLastFieldOwner(int id)
   {
-    lastFieldOwner = id;
+    uint64_t old = lastFieldValue();
+    lastFieldOwner = static_cast<int8_t>(id);
+    if (hash) hash->change(HashFeature::LastField, handle, old, lastFieldValue());
   }
 
   // --------------------------------------------------------------------------
@@ -252,7 +262,7 @@ public:
   // --------------------------------------------------------------------------
   int getBaseATK() const
   {
-    return baseATK;
+    return definition->baseATK;
   }
 
   // --------------------------------------------------------------------------
@@ -262,7 +272,7 @@ public:
   // --------------------------------------------------------------------------
   int getBaseHP() const
   {
-    return baseHP;
+    return definition->baseHP;
   }
 
   // --------------------------------------------------------------------------
@@ -293,7 +303,7 @@ public:
   // --------------------------------------------------------------------------
   bool hasTrait(Trait t) const
   {
-    return std::find(traits.begin(), traits.end(), t) != traits.end();
+    return traits.has(t);
   }
 
   // --------------------------------------------------------------------------
@@ -303,6 +313,10 @@ public:
   // --------------------------------------------------------------------------
   void setSummonedRound(int round)
   {
+    if (hash)
+    {
+      hash->change(HashFeature::SummonedRound, handle, static_cast<uint32_t>(summonedRound), static_cast<uint32_t>(round));
+    }
     summonedRound = round;
   }
 
@@ -313,11 +327,7 @@ public:
   // --------------------------------------------------------------------------
   void takeDamage(int amount)
   {
-    curHP -= amount;
-    if (curHP < 0)
-    {
-      curHP = 0;
-    }
+    assignHealth(max(0, curHP - amount));
   }
 
   // --------------------------------------------------------------------------
@@ -336,9 +346,9 @@ public:
   // --------------------------------------------------------------------------
   void resetStats() override
   {
-    curATK = baseATK;
-    curHP = baseHP;
-    traits = baseTraits;
+    assignAttack(definition->baseATK);
+    assignHealth(definition->baseHP);
+    assignTraits(definition->baseTraits);
   }
 
   // --------------------------------------------------------------------------
@@ -348,10 +358,9 @@ public:
   // --------------------------------------------------------------------------
   void addTrait(Trait t)
   {
-    if (!hasTrait(t))
-    {
-      traits.push_back(t);
-    }
+    TraitSet changed = traits;
+    changed.add(t);
+    assignTraits(changed);
   }
 
   // --------------------------------------------------------------------------
@@ -361,7 +370,7 @@ public:
   // --------------------------------------------------------------------------
   void increaseAttack(int amount)
   {
-    curATK += amount;
+    assignAttack(curATK + amount);
   }
 
   // --------------------------------------------------------------------------
@@ -371,7 +380,7 @@ public:
   // --------------------------------------------------------------------------
   void increaseHealth(int amount)
   {
-    curHP += amount;
+    assignHealth(curHP + amount);
   }
 
   // --------------------------------------------------------------------------
@@ -381,11 +390,7 @@ public:
   // --------------------------------------------------------------------------
   void decreaseHealth(int amount)
   {
-    curHP -= amount;
-    if (curHP < 0)
-    {
-      curHP = 0;
-    }
+    assignHealth(max(0, curHP - amount));
   }
 
   // --------------------------------------------------------------------------
@@ -395,7 +400,7 @@ public:
   // --------------------------------------------------------------------------
   void setHealth(int hp)
   {
-    curHP = hp;
+    assignHealth(hp);
   }
 
   // --------------------------------------------------------------------------
@@ -404,21 +409,19 @@ public:
   // --------------------------------------------------------------------------
   void removeFirstTraitAlphabetically()
   {
-    if (!traits.empty())
-    {
-      sort(traits.begin(), traits.end(), [](Trait a, Trait b)
-      {
-        return traitToString(a) < traitToString(b);
-      });
-      traits.erase(traits.begin());
-    }
+    TraitSet changed = traits;
+    changed.removeFirst();
+    assignTraits(changed);
   }
 
   // Prints all key details of the card (ID, traits, mana, attack, health).
   // Used when displaying the card in ASCII board format.
+  //
+  // @param os Stream the card is written to
   // --------------------------------------------------------------------------
-  void printCardDetails() const override
+  void printCardDetails(ostream &os) const override
   {
+    int manaCost = definition->manaCost;
     string manaStr = (manaCost == -1) ? "XX" : to_string(manaCost);
     while (manaStr.length() < 2)
     {
@@ -437,19 +440,19 @@ public:
       hpStr = "0" + hpStr;
     }
 
-    string traitLetters = getTraitsString();
+    string traitLetters(traitCode(traits));
     while (traitLetters.length() < 5)
     {
       traitLetters += " ";
     }
 
 
-    string cardID = id;
+    const string &cardID = definition->id;
 
-    cout << " _____M" << manaStr << endl;
-    cout << "| " << cardID << " |" << endl;
-    cout << "| " << traitLetters << " |" << endl;
-    cout << "A" << atkStr << "___H" << hpStr << endl;
+    os << " _____M" << manaStr << "\n";
+    os << "| " << cardID << " |" << "\n";
+    os << "| " << traitLetters << " |" << "\n";
+    os << "A" << atkStr << "___H" << hpStr << "\n";
   }
 };
 
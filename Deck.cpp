@@ -1,7 +1,7 @@
 // --------------------------- Deck.cpp ---------------------------
 //
-// This file implements the Deck class, which loads, stores and draws
-// cards from a predefined sequence using a CardFactory for instantitation.
+// This file implements the Deck class, a ring buffer of card handles
+// loaded from a predefined sequence using a CardFactory for instantitation.
 //
 // Group: 051
 //
@@ -9,14 +9,15 @@
 // ------------------------------------------------------------------------
 #include "Deck.hpp"
 #include "CardFactory.hpp"
-#include <memory>
+#include "StateHash.hpp"
+#include "UndoJournal.hpp"
 
 using namespace std; // bring std names into scope for clarity
 
 // --------------------------------------------------------------------------
 // Loads a sequence of card IDs into the deck by querying the factory.
-// Clears any existing cards, then adds valid ones.
-// Resets the draw pointer to the top.
+// Clears any existing cards, then adds valid ones in order, so the
+// first ID is drawn first.
 //
 // @param cardIDs Vector of string card IDs to load
 // @param factory CardFactory used to instantiate cards
@@ -26,28 +27,105 @@ void Deck::loadFromIDs(const vector<string> &cardIDs, CardFactory &factory)
   cards.clear(); // remove previous contents
   for (const auto &id: cardIDs)
   {
-    auto card = factory.createCardByID(id);
-    if (card)
+    CardHandle card = factory.createCardByID(id);
+    if (card != NO_CARD)
     {
       cards.push_back(card);
     }
-    // if factory returns nullptr, skip invalid ID
+    // if factory returns NO_CARD, skip invalid ID
   }
-  currentIndex = 0; // reset draw pointer to top of deck
+  top = 0; // the buffer is linear right after loading
+  count = cards.size();
+  firstSequence = 0;
 }
 
 // --------------------------------------------------------------------------
-// Draws the next card from the deck if available.
+// Draws the top card from the deck if available.
 //
-// @return shared_ptr to the drawn card, or nullptr if deck is empty
+// @return Handle of the drawn card, or NO_CARD if deck is empty
 // --------------------------------------------------------------------------
-shared_ptr<Card> Deck::draw()
+CardHandle Deck::draw()
 {
   if (isEmpty())
   {
-    return nullptr;
+    return NO_CARD;
+  }
+  CardHandle card = cards[top];
+  if (journal)
+  {
+    journal->save(top);
+    journal->save(count);
+    journal->save(firstSequence);
+  }
+  if (hash) hash->toggle(HashFeature::CardInDeck, card, (static_cast<uint64_t>(owner) << 32) | firstSequence);
+  ++firstSequence;
+  top = (top + 1 == cards.size()) ? 0 : top + 1;
+  --count;
+  return card;
+}
+
+// --------------------------------------------------------------------------
+// Adds a card under the bottom card. When the buffer is full it is
+// doubled and unrolled so the top card moves back to index 0.
+//
+// @param card Handle of the card to add
+// --------------------------------------------------------------------------
+void Deck::pushBottom(CardHandle card)
+{
+  if (journal)
+  {
+    if (count == cards.size()) journal->saveStorage(cards);
+    journal->save(top);
+    journal->save(count);
+  }
+  if (count == cards.size())
+  {
+    vector<CardHandle> grown(max<size_t>(8, cards.size() * 2), NO_CARD);
+    for (size_t i = 0; i < count; ++i)
+    {
+      grown[i] = at(i);
+    }
+    cards.swap(grown);
+    top = 0;
+  }
+  size_t bottom = top + count;
+  if (bottom >= cards.size()) bottom -= cards.size();
+  if (journal) journal->save(cards[bottom]);
+  if (hash)
+  {
+    uint32_t sequence = firstSequence + static_cast<uint32_t>(count);
+    hash->toggle(HashFeature::CardInDeck, card, (static_cast<uint64_t>(owner) << 32) | sequence);
+  }
+  cards[bottom] = card;
+  ++count;
+}
+
+// --------------------------------------------------------------------------
+// Empties the deck without releasing the buffer, so refilling it with
+// pushBottom does not allocate.
+//
+// @param sequence Sequence number the next top card gets
+// --------------------------------------------------------------------------
+void Deck::clear(uint32_t sequence)
+{
+  top = 0;
+  count = 0;
+  firstSequence = sequence;
+}
+
+// --------------------------------------------------------------------------
+// Toggles the CardInDeck fact of every card, e.g. to build a hash from
+// scratch.
+//
+// @param target Hash to update
+// --------------------------------------------------------------------------
+void Deck::hashCards(StateHash &target) const
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint32_t sequence = firstSequence + static_cast<uint32_t>(i);
+    target.toggle(HashFeature::CardInDeck, at(i), (static_cast<uint64_t>(owner) << 32) | sequence);
   }
-  return cards[currentIndex++];
 }
 
 // --------------------------------------------------------------------------
@@ -57,7 +135,7 @@ shared_ptr<Card> Deck::draw()
 // --------------------------------------------------------------------------
 bool Deck::isEmpty() const
 {
-  return currentIndex >= cards.size();
+  return count == 0;
 }
 
 // --------------------------------------------------------------------------
@@ -67,15 +145,18 @@ bool Deck::isEmpty() const
 // --------------------------------------------------------------------------
 size_t Deck::remaining() const
 {
-  return cards.size() - currentIndex;
+  return count;
 }
 
 // --------------------------------------------------------------------------
-// Provides read-only access to the full card list.
+// Returns the card at a position counted from the top.
 //
-// @return const reference to the vector of card pointers
+// @param position Position in [0, remaining())
+// @return Handle of the card at that position
 // --------------------------------------------------------------------------
-const vector<shared_ptr<Card> > &Deck::getCards() const
+CardHandle Deck::at(size_t position) const
 {
-  return cards;
+  size_t index = top + position;
+  if (index >= cards.size()) index -= cards.size();
+  return cards[index];
 }
@@ -1,8 +1,8 @@
 // --------------------------- Deck.hpp ---------------------------
 //
 // This file declares the Deck class, which stores and manages a player's
-// deck of cards. It supports loading cards from a factory, drawing cards,
-// and tracking the remaining number of cards.
+// draw pile. It supports loading cards from a factory, drawing from the
+// top, returning cards to the bottom and tracking the remaining cards.
 //
 // Group: 051
 //
@@ -11,14 +11,14 @@
 #pragma once
 
 #include <vector>
-#include <memory>
 #include <string>
-#include "Card.hpp"
+#include "CardPool.hpp"
 
 class CardFactory;
 
 // --------------------------------------------------------------------------
-// Deck: Represents a deck of cards with draw functionality.
+// Deck: A draw pile stored as a ring buffer of card handles. Drawing from
+// the top and putting a card under the bottom are both O(1).
 // --------------------------------------------------------------------------
 class Deck
 {
@@ -30,7 +30,7 @@ public:
 
   // ----------------------------------------------------------------------
   // Loads a sequence of card IDs into the deck using the CardFactory.
-  // Resets internal draw pointer to the start.
+  // The first ID becomes the top card.
   //
   // @param cardIDs Vector of card ID strings
   // @param factory Reference to CardFactory for creating card instances
@@ -38,11 +38,18 @@ public:
   void loadFromIDs(const std::vector<std::string> &cardIDs, CardFactory &factory);
 
   // ----------------------------------------------------------------------
-  // Draws the next available card from the deck.
+  // Removes and returns the top card of the deck.
   //
-  // @return shared_ptr<Card> if available, nullptr if deck is empty
+  // @return Handle of the card if available, NO_CARD if deck is empty
   // ----------------------------------------------------------------------
-  std::shared_ptr<Card> draw();
+  CardHandle draw();
+
+  // ----------------------------------------------------------------------
+  // Puts a card under the bottom of the deck, growing the buffer if full.
+  //
+  // @param card Handle of the card to add
+  // ----------------------------------------------------------------------
+  void pushBottom(CardHandle card);
 
   // ----------------------------------------------------------------------
   // Checks whether the deck is empty (no more cards to draw).
@@ -59,13 +66,62 @@ public:
   size_t remaining() const;
 
   // ----------------------------------------------------------------------
-  // Provides read-only access to all loaded cards (used for Player setup).
+  // Returns the card at a position counted from the top (0 = next draw).
+  //
+  // @param position Position in [0, remaining())
+  // @return Handle of the card at that position
+  // ----------------------------------------------------------------------
+  CardHandle at(size_t position) const;
+
+  // ----------------------------------------------------------------------
+  // Removes all cards, keeping the buffer for reuse.
+  //
+  // @param sequence Sequence number the next top card gets
+  // ----------------------------------------------------------------------
+  void clear(uint32_t sequence = 0);
+
+  // ----------------------------------------------------------------------
+  // Returns the sequence number of the top card. Cards are numbered in
+  // the order they are put into the deck, so a card keeps its number
+  // while the cards above it are drawn.
+  //
+  // @return Sequence number of the top card
+  // ----------------------------------------------------------------------
+  uint32_t getFirstSequence() const { return firstSequence; }
+
+  // ----------------------------------------------------------------------
+  // Sets the state hash that tracks the deck's cards and the owner
+  // they are hashed under.
+  //
+  // @param stateHash Hash of the owning game (nullptr for none)
+  // @param ownerId   ID of the player owning the deck
+  // ----------------------------------------------------------------------
+  void bindStateHash(StateHash *stateHash, int ownerId)
+  {
+    hash = stateHash;
+    owner = static_cast<uint8_t>(ownerId);
+  }
+
+  // ----------------------------------------------------------------------
+  // Toggles the facts of all cards in the deck in a hash.
+  //
+  // @param target Hash to update
+  // ----------------------------------------------------------------------
+  void hashCards(StateHash &target) const;
+
+  // ----------------------------------------------------------------------
+  // Sets the journal that records draws and cards put under the deck.
   //
-  // @return const reference to vector of shared_ptr<Card>
+  // @param undo Journal of the owning game (nullptr for none)
   // ----------------------------------------------------------------------
-  const std::vector<std::shared_ptr<Card> > &getCards() const;
+  void bindUndoJournal(UndoJournal *undo) { journal = undo; }
 
 private:
-  std::vector<std::shared_ptr<Card> > cards;
-  size_t currentIndex = 0;
+  std::vector<CardHandle> cards; // ring storage; its size is the capacity
+  size_t top = 0; // index of the top card in cards
+  size_t count = 0; // number of cards in the deck
+  uint32_t firstSequence = 0; // sequence number of the top card
+  UndoJournal *journal = nullptr; // records changes while an action can be undone
+  StateHash *hash = nullptr; // hash of the owning game
+  uint8_t owner = 0; // owner ID used in the hash
 };
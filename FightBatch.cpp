@@ -0,0 +1,240 @@
+// --------------------------- FightBatch.cpp ---------------------------
+//
+// Implements the FightBatch: the branch-free fight kernel in AVX-512,
+// AVX2 and plain C++ with the choice made at run time, and the scalar
+// path for fights with special traits.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "FightBatch.hpp"
+#include <algorithm>
+
+// The vector kernels are compiled for their instruction set with a target attribute and only
+// called after the CPU check, so every x86 build carries them without -mavx2
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define FIGHT_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+  constexpr int32_t traitBit(Trait trait) { return 1 << static_cast<unsigned>(trait); }
+
+  // Traits whose effects go beyond trading damage
+  constexpr int32_t SPECIAL_TRAITS =
+      traitBit(Trait::Brutal) | traitBit(Trait::Lifesteal) | traitBit(Trait::Poisoned) | traitBit(Trait::Venomous);
+
+  // Columns are padded to whole AVX-512 registers; the padding lanes are 0/0 fights
+  constexpr size_t WIDTH = 16;
+
+  // Columns of the branch-free lanes
+  struct Columns
+  {
+    const int32_t *attackerAttack;
+    const int32_t *attackerHealth;
+    const int32_t *attackerFirst;
+    const int32_t *defenderAttack;
+    const int32_t *defenderHealth;
+    const int32_t *defenderFirst;
+    int32_t *attackerAfter;
+    int32_t *defenderAfter;
+  };
+
+  using Kernel = void (*)(const Columns &, size_t);
+
+  // Without First Strike on exactly one side both creatures hit; otherwise the first striker hits
+  // and the other one hits back only if it survived
+  void resolvePlain(const Columns &c, size_t count)
+  {
+    for (size_t lane = 0; lane < count; ++lane)
+    {
+      const bool attackerFirst = c.attackerFirst[lane] != 0;
+      const bool defenderFirst = c.defenderFirst[lane] != 0;
+      const int32_t attackerHit = max(0, c.attackerHealth[lane] - c.defenderAttack[lane]);
+      const int32_t defenderHit = max(0, c.defenderHealth[lane] - c.attackerAttack[lane]);
+
+      c.attackerAfter[lane] = (attackerFirst && !defenderFirst && defenderHit == 0) ? c.attackerHealth[lane]
+                                                                                    : attackerHit;
+      c.defenderAfter[lane] = (defenderFirst && !attackerFirst && attackerHit == 0) ? c.defenderHealth[lane]
+                                                                                    : defenderHit;
+    }
+  }
+
+#ifdef FIGHT_BATCH_X86
+  // resolvePlain() for 8 lanes per instruction; count is a multiple of WIDTH
+  __attribute__((target("avx2"))) void resolveAvx2(const Columns &c, size_t count)
+  {
+    const __m256i zero = _mm256_setzero_si256();
+    for (size_t at = 0; at < count; at += 8)
+    {
+      const __m256i attackerHP = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c.attackerHealth + at));
+      const __m256i defenderHP = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c.defenderHealth + at));
+      const __m256i attackerFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c.attackerFirst + at));
+      const __m256i defenderFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c.defenderFirst + at));
+      const __m256i attackerATK = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c.attackerAttack + at));
+      const __m256i defenderATK = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(c.defenderAttack + at));
+      const __m256i attackerHit = _mm256_max_epi32(zero, _mm256_sub_epi32(attackerHP, defenderATK));
+      const __m256i defenderHit = _mm256_max_epi32(zero, _mm256_sub_epi32(defenderHP, attackerATK));
+
+      // A creature struck first and killed does not hit back
+      const __m256i attackerSpared = _mm256_and_si256(_mm256_andnot_si256(defenderFirst, attackerFirst),
+                                                      _mm256_cmpeq_epi32(defenderHit, zero));
+      const __m256i defenderSpared = _mm256_and_si256(_mm256_andnot_si256(attackerFirst, defenderFirst),
+                                                      _mm256_cmpeq_epi32(attackerHit, zero));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(c.attackerAfter + at),
+                          _mm256_blendv_epi8(attackerHit, attackerHP, attackerSpared));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(c.defenderAfter + at),
+                          _mm256_blendv_epi8(defenderHit, defenderHP, defenderSpared));
+    }
+  }
+
+  // resolvePlain() for 16 lanes per instruction; count is a multiple of WIDTH
+  __attribute__((target("avx512f"))) void resolveAvx512(const Columns &c, size_t count)
+  {
+    const __m512i zero = _mm512_setzero_si512();
+    for (size_t at = 0; at < count; at += 16)
+    {
+      const __m512i attackerHP = _mm512_loadu_si512(c.attackerHealth + at);
+      const __m512i defenderHP = _mm512_loadu_si512(c.defenderHealth + at);
+      const __m512i attackerFirstBits = _mm512_loadu_si512(c.attackerFirst + at);
+      const __m512i defenderFirstBits = _mm512_loadu_si512(c.defenderFirst + at);
+      const __mmask16 attackerFirst = _mm512_test_epi32_mask(attackerFirstBits, attackerFirstBits);
+      const __mmask16 defenderFirst = _mm512_test_epi32_mask(defenderFirstBits, defenderFirstBits);
+      const __m512i attackerLeft = _mm512_sub_epi32(attackerHP, _mm512_loadu_si512(c.defenderAttack + at));
+      const __m512i defenderLeft = _mm512_sub_epi32(defenderHP, _mm512_loadu_si512(c.attackerAttack + at));
+      // max(0, left) by keeping the positive lanes
+      const __m512i attackerHit = _mm512_maskz_mov_epi32(_mm512_cmpgt_epi32_mask(attackerLeft, zero), attackerLeft);
+      const __m512i defenderHit = _mm512_maskz_mov_epi32(_mm512_cmpgt_epi32_mask(defenderLeft, zero), defenderLeft);
+
+      // A creature struck first and killed does not hit back
+      const __mmask16 attackerSpared = attackerFirst & ~defenderFirst & _mm512_cmpeq_epi32_mask(defenderHit, zero);
+      const __mmask16 defenderSpared = defenderFirst & ~attackerFirst & _mm512_cmpeq_epi32_mask(attackerHit, zero);
+
+      _mm512_storeu_si512(c.attackerAfter + at, _mm512_mask_blend_epi32(attackerSpared, attackerHit, attackerHP));
+      _mm512_storeu_si512(c.defenderAfter + at, _mm512_mask_blend_epi32(defenderSpared, defenderHit, defenderHP));
+    }
+  }
+#endif
+
+  // The widest kernel the CPU supports, and its name
+  pair<Kernel, const char *> selectKernel()
+  {
+#ifdef FIGHT_BATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return {resolveAvx512, "avx512"};
+    if (__builtin_cpu_supports("avx2")) return {resolveAvx2, "avx2"};
+#endif
+    return {resolvePlain, "plain"};
+  }
+
+  const pair<Kernel, const char *> &kernel()
+  {
+    static const pair<Kernel, const char *> selected = selectKernel();
+    return selected;
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Appends a lane, reusing the storage of earlier batches. Fights with special traits are kept
+/// apart so that the kernel only sees pure damage trades.
+///
+/// @param attacker Creature of the attacking player
+/// @param defender Creature of the defending player
+/// @return false if a stat is out of range
+//---------------------------------------------------------------------------------------------------------------------
+bool FightBatch::add(const FightStats &attacker, const FightStats &defender)
+{
+  for (const FightStats *stats: {&attacker, &defender})
+  {
+    if (stats->attack < 0 || stats->attack > MAX_STAT || stats->health < 0 || stats->health > MAX_STAT ||
+        stats->baseHealth < 0 || stats->baseHealth > MAX_STAT)
+    {
+      return false;
+    }
+  }
+
+  if (lanes == laneIndex.size()) laneIndex.push_back(0);
+  if (((attacker.traits.getBits() | defender.traits.getBits()) & SPECIAL_TRAITS) != 0)
+  {
+    laneIndex[lanes++] = ~static_cast<int32_t>(specialFights.size());
+    specialFights.emplace_back(attacker, defender);
+    return true;
+  }
+
+  if (plainLanes == attackerAttack.size())
+  {
+    for (vector<int32_t> *column: {&attackerAttack, &attackerHealth, &attackerFirst, &defenderAttack,
+                                   &defenderHealth, &defenderFirst})
+    {
+      column->push_back(0);
+    }
+  }
+  attackerAttack[plainLanes] = attacker.attack;
+  attackerHealth[plainLanes] = attacker.health;
+  attackerFirst[plainLanes] = attacker.traits.has(Trait::FirstStrike) ? -1 : 0;
+  defenderAttack[plainLanes] = defender.attack;
+  defenderHealth[plainLanes] = defender.health;
+  defenderFirst[plainLanes] = defender.traits.has(Trait::FirstStrike) ? -1 : 0;
+  laneIndex[lanes++] = static_cast<int32_t>(plainLanes++);
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Runs the branch-free lanes through the kernel chosen for this CPU and the lanes with special
+/// traits through FightTable::resolve.
+//---------------------------------------------------------------------------------------------------------------------
+void FightBatch::resolve()
+{
+  if (plainLanes > 0)
+  {
+    const size_t padded = (plainLanes + WIDTH - 1) / WIDTH * WIDTH;
+    for (vector<int32_t> *column: {&attackerAttack, &attackerHealth, &attackerFirst, &defenderAttack,
+                                   &defenderHealth, &defenderFirst, &attackerAfter, &defenderAfter})
+    {
+      if (column->size() < padded) column->resize(padded);
+    }
+    // Columns beyond plainLanes may hold lanes of an earlier batch; their results are never read
+    kernel().first({attackerAttack.data(), attackerHealth.data(), attackerFirst.data(), defenderAttack.data(),
+                    defenderHealth.data(), defenderFirst.data(), attackerAfter.data(), defenderAfter.data()},
+                   padded);
+  }
+
+  special.clear();
+  for (const pair<FightStats, FightStats> &fight: specialFights)
+  {
+    special.push_back(FightTable::resolve(fight.first, fight.second));
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the outcome of a lane. Branch-free lanes change no player health and add no traits.
+///
+/// @param lane Index of the fight
+/// @return Outcome of the fight
+//---------------------------------------------------------------------------------------------------------------------
+FightOutcome FightBatch::outcome(size_t lane) const
+{
+  const int32_t index = laneIndex[lane];
+  if (index < 0) return special[~index];
+  FightOutcome plain;
+  plain.attackerHealth = static_cast<int16_t>(attackerAfter[index]);
+  plain.defenderHealth = static_cast<int16_t>(defenderAfter[index]);
+  return plain;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// @return Name of the kernel chosen for this CPU
+//---------------------------------------------------------------------------------------------------------------------
+const char *FightBatch::kernelName()
+{
+  return kernel().second;
+}
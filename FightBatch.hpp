@@ -0,0 +1,112 @@
+// --------------------------- FightBatch.hpp ---------------------------
+//
+// Declares the FightBatch, a structure-of-arrays batch of independent
+// battle slot fights resolved together, 16 or 8 at a time with AVX-512
+// or AVX2 when the CPU supports it.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "FightTable.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Fights of one slot each, from the battle phases of one or many games. The fights must not share
+/// creatures, which holds for the slots of one battle phase and for separate games.
+///
+/// Most fights only trade damage, with at most one First Strike creature deciding the order; these
+/// lanes are resolved branch-free, 16 per AVX-512 or 8 per AVX2 instruction or in a plain loop,
+/// whichever the CPU supports (chosen at run time, so the default build needs no -mavx2). Lanes
+/// with Brutal, Lifesteal, Poisoned or Venomous creatures are split off by add() and go to
+/// FightTable::resolve only.
+///
+/// One battle phase has at most 7 fights; the LockstepSimulator fills the vectors with the battle
+/// phases of many games. Storage grows with the largest batch and is kept by clear(), so a reused
+/// batch does not allocate.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class FightBatch
+{
+public:
+  static constexpr int MAX_STAT = 16000; ///< larger stats could overflow the outcome fields
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Removes all fights.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void clear()
+  {
+    lanes = 0;
+    plainLanes = 0;
+    specialFights.clear();
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Adds a fight as the next lane.
+  ///
+  /// @param attacker Creature of the attacking player
+  /// @param defender Creature of the defending player
+  ///
+  /// @return false if a stat is negative or above MAX_STAT; the fight is not added
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool add(const FightStats &attacker, const FightStats &defender);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Number of fights in the batch
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  size_t size() const { return lanes; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Resolves all fights added since the last clear().
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void resolve();
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param lane Index of a fight (in the order of add)
+  ///
+  /// @return The outcome of the fight (after resolve)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  FightOutcome outcome(size_t lane) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Name of the kernel resolve() uses on this CPU: "avx512", "avx2" or "plain"
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static const char *kernelName();
+
+private:
+  size_t lanes = 0;
+  size_t plainLanes = 0;
+  std::vector<int32_t> laneIndex; // column of a branch-free lane, or ~index into special
+
+  // Branch-free lanes, one entry per column; First Strike as a 0 / -1 mask
+  std::vector<int32_t> attackerAttack;
+  std::vector<int32_t> attackerHealth;
+  std::vector<int32_t> attackerFirst;
+  std::vector<int32_t> defenderAttack;
+  std::vector<int32_t> defenderHealth;
+  std::vector<int32_t> defenderFirst;
+  std::vector<int32_t> attackerAfter;
+  std::vector<int32_t> defenderAfter;
+
+  // Lanes with special traits and their outcomes
+  std::vector<std::pair<FightStats, FightStats> > specialFights;
+  std::vector<FightOutcome> special;
+};
@@ -0,0 +1,162 @@
+// --------------------------- FightTable.cpp ---------------------------
+//
+// Implements the FightTable: the fight rules of the battle phase as a pure
+// function and the table of their results built at catalog load.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "FightTable.hpp"
+#include <algorithm>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Adds a health change to the next free entry of a player's list.
+///
+/// @param changes Health changes of one player
+/// @param amount  Change (not 0)
+//---------------------------------------------------------------------------------------------------------------------
+static void addPlayerChange(int16_t (&changes)[2], int amount)
+{
+  changes[(changes[0] == 0) ? 0 : 1] = static_cast<int16_t>(amount);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Lets one creature hit the other and applies what the battle phase applies after each hit:
+/// Brutal overkill to the owner of the hit creature (measured from the health before the hit, or
+/// from its base health), Poisoned from Poisoned and Venomous hitters, and Lifesteal healing by
+/// the damage (which Brutal has raised by 1). This is the shared part of the six hits written out
+/// in Game::processBattlePhase; the flags cover the places where those hits differ.
+///
+/// @param hitter           Creature dealing the damage
+/// @param damage           Its damage, raised by 1 afterwards if it is Brutal
+/// @param target           Creature taking the damage
+/// @param hitterChanges    Health changes of the hitter's player
+/// @param targetChanges    Health changes of the target's player
+/// @param targetPoisoned   Set if the target gains Poisoned
+/// @param overkillFromBase Overkill is measured from the target's base health
+/// @param venomAlways      Venomous poisons the target even if it died
+/// @param stopOnKill       Nothing but the overkill happens if the target dies
+///
+/// @return false if the hit killed the target and stopOnKill is set
+//---------------------------------------------------------------------------------------------------------------------
+static bool hit(FightStats &hitter, int &damage, FightStats &target, int16_t (&hitterChanges)[2],
+                int16_t (&targetChanges)[2], bool &targetPoisoned, bool overkillFromBase, bool venomAlways,
+                bool stopOnKill)
+{
+  const bool brutal = hitter.traits.has(Trait::Brutal);
+  const int before = target.health;
+  target.health = max(0, target.health - damage);
+
+  if (brutal && target.health <= 0)
+  {
+    int overkill = damage - (overkillFromBase ? target.baseHealth : before);
+    if (overkill > 0) addPlayerChange(targetChanges, -overkill);
+  }
+  if (brutal) damage += 1;
+  if (stopOnKill && target.health <= 0) return false;
+
+  if ((target.health > 0 && hitter.traits.has(Trait::Poisoned)) ||
+      ((target.health > 0 || venomAlways) && hitter.traits.has(Trait::Venomous)))
+  {
+    target.traits.add(Trait::Poisoned);
+    targetPoisoned = true;
+  }
+  if (hitter.traits.has(Trait::Lifesteal)) addPlayerChange(hitterChanges, damage);
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Follows the three cases of the battle phase: the attacker striking first, the defender striking
+/// first, and no First Strike deciding the order.
+///
+/// @param attacker Creature of the attacking player
+/// @param defender Creature of the defending player
+///
+/// @return Outcome of the fight
+//---------------------------------------------------------------------------------------------------------------------
+FightOutcome FightTable::resolve(FightStats attacker, FightStats defender)
+{
+  FightOutcome out;
+  int attackerDamage = attacker.attack;
+  int defenderDamage = defender.attack;
+  const bool attackerFirst = attacker.traits.has(Trait::FirstStrike);
+  const bool defenderFirst = defender.traits.has(Trait::FirstStrike);
+
+  if (attackerFirst && !defenderFirst)
+  {
+    if (hit(attacker, attackerDamage, defender, out.attackerPlayer, out.defenderPlayer, out.defenderPoisoned,
+            false, false, true))
+    {
+      hit(defender, defenderDamage, attacker, out.defenderPlayer, out.attackerPlayer, out.attackerPoisoned,
+          false, false, true);
+    }
+  }
+  else if (defenderFirst && !attackerFirst)
+  {
+    hit(defender, defenderDamage, attacker, out.defenderPlayer, out.attackerPlayer, out.attackerPoisoned,
+        true, false, false);
+    if (attacker.health > 0)
+    {
+      hit(attacker, attackerDamage, defender, out.attackerPlayer, out.defenderPlayer, out.defenderPoisoned,
+          true, false, false);
+    }
+  }
+  else
+  {
+    hit(attacker, attackerDamage, defender, out.attackerPlayer, out.defenderPlayer, out.defenderPoisoned,
+        true, false, false);
+    hit(defender, defenderDamage, attacker, out.defenderPlayer, out.attackerPlayer, out.attackerPoisoned,
+        true, true, false);
+  }
+
+  out.attackerHealth = static_cast<int16_t>(attacker.health);
+  out.defenderHealth = static_cast<int16_t>(defender.health);
+  return out;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Assigns the profiles of every creature kind and resolves all profile pairs.
+///
+/// @param definitions All card definitions, indexed by kind
+//---------------------------------------------------------------------------------------------------------------------
+void FightTable::build(const vector<CardDefinition> &definitions)
+{
+  kinds.assign(definitions.size(), KindProfiles());
+  vector<FightStats> profiles;
+  for (const CardDefinition &definition: definitions)
+  {
+    if (definition.type != CardType::Creature || definition.baseHP < 1 || definition.baseHP > MAX_STAT ||
+        definition.baseATK < 0 || definition.baseATK > MAX_STAT ||
+        profiles.size() + definition.baseHP > static_cast<size_t>(MAX_PROFILES))
+    {
+      continue;
+    }
+
+    KindProfiles &entry = kinds[definition.kind];
+    entry.first = static_cast<int>(profiles.size());
+    entry.attack = definition.baseATK;
+    entry.baseHealth = definition.baseHP;
+    entry.traits = definition.baseTraits.getBits() & RELEVANT_TRAITS;
+    for (int health = 1; health <= definition.baseHP; ++health)
+    {
+      profiles.push_back({definition.baseATK, health, definition.baseHP, TraitSet(entry.traits)});
+    }
+  }
+
+  profileCount = static_cast<int>(profiles.size());
+  outcomes.resize(profiles.size() * profiles.size());
+  for (size_t a = 0; a < profiles.size(); ++a)
+  {
+    for (size_t d = 0; d < profiles.size(); ++d)
+    {
+      outcomes[a * profiles.size() + d] = resolve(profiles[a], profiles[d]);
+    }
+  }
+}
@@ -0,0 +1,147 @@
+// --------------------------- FightTable.hpp ---------------------------
+//
+// Declares the FightTable, the precomputed outcome of every battle slot
+// fight between two creatures of the catalog at their base attack and
+// traits, used by silent games to resolve a fight with one lookup.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "CardDefinition.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Result of one fight in a battle slot. Player health changes are listed in the order the battle
+/// phase makes them, because player health is clamped at 0 after every change.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct FightOutcome
+{
+  int16_t attackerHealth = 0; ///< health of the attacking creature after the fight
+  int16_t defenderHealth = 0; ///< health of the defending creature after the fight
+  int16_t attackerPlayer[2] = {0, 0}; ///< health changes of the attacking player, 0 = none
+  int16_t defenderPlayer[2] = {0, 0}; ///< health changes of the defending player, 0 = none
+  bool attackerPoisoned = false; ///< the attacking creature gains Poisoned
+  bool defenderPoisoned = false; ///< the defending creature gains Poisoned
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Stats of a creature that decide a fight.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct FightStats
+{
+  int attack = 0;
+  int health = 0;
+  int baseHealth = 0; ///< used for the Brutal overkill when no First Strike decides the order
+  TraitSet traits;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Outcomes of all fights between profiles. A profile is a creature kind at its base attack and
+/// base traits with a health between 1 and its base health, which covers every creature that no
+/// spell has changed. Creatures outside the table (buffed, cursed, poisoned, ...) have no profile
+/// and are resolved by the general battle code.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class FightTable
+{
+public:
+  static constexpr int NO_PROFILE = -1;
+  static constexpr int MAX_PROFILES = 512; ///< limits the table to 3.5 MB
+  static constexpr int MAX_STAT = 100; ///< creatures with larger base stats get no profiles
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Builds the table for the creature definitions of a catalog. Kinds are added in catalog order
+  /// until MAX_PROFILES is reached.
+  ///
+  /// @param definitions All card definitions, indexed by kind
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void build(const std::vector<CardDefinition> &definitions);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Finds the profile of a creature.
+  ///
+  /// @param kind       Kind of the creature
+  /// @param attack     Current attack
+  /// @param health     Current health
+  /// @param baseHealth Base health of the creature
+  /// @param traits     Current traits
+  ///
+  /// @return Profile index, or NO_PROFILE if the creature is not covered
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  int profile(CardKind kind, int attack, int health, int baseHealth, TraitSet traits) const
+  {
+    if (kind >= kinds.size()) return NO_PROFILE;
+    const KindProfiles &entry = kinds[kind];
+    if (entry.first == NO_PROFILE || attack != entry.attack || baseHealth != entry.baseHealth ||
+        health < 1 || health > baseHealth || (traits.getBits() & RELEVANT_TRAITS) != entry.traits)
+    {
+      return NO_PROFILE;
+    }
+    return entry.first + health - 1;
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param attacker Profile of the creature of the attacking player
+  /// @param defender Profile of the creature of the defending player
+  ///
+  /// @return Outcome of their fight
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  const FightOutcome &outcome(int attacker, int defender) const
+  {
+    return outcomes[static_cast<size_t>(attacker) * profileCount + defender];
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Number of profiles in the table
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  int size() const { return profileCount; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Resolves a fight by the rules of Game::processBattlePhase. Used to fill the table. Stats up
+  /// to FightBatch::MAX_STAT keep every result within the outcome fields.
+  ///
+  /// @param attacker Creature of the attacking player
+  /// @param defender Creature of the defending player
+  ///
+  /// @return Outcome of the fight
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static FightOutcome resolve(FightStats attacker, FightStats defender);
+
+private:
+  // Traits read by a fight; the others must not split profiles
+  static constexpr uint16_t RELEVANT_TRAITS =
+      (1u << static_cast<unsigned>(Trait::Brutal)) | (1u << static_cast<unsigned>(Trait::FirstStrike)) |
+      (1u << static_cast<unsigned>(Trait::Lifesteal)) | (1u << static_cast<unsigned>(Trait::Poisoned)) |
+      (1u << static_cast<unsigned>(Trait::Venomous));
+
+  struct KindProfiles
+  {
+    int first = NO_PROFILE; // profile of health 1, the others follow
+    int attack = 0;
+    int baseHealth = 0;
+    uint16_t traits = 0; // relevant base traits
+  };
+
+  std::vector<KindProfiles> kinds; // indexed by kind
+  std::vector<FightOutcome> outcomes; // profileCount x profileCount, attacker major
+  int profileCount = 0;
+};
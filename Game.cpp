@@ -7,10 +7,15 @@
 //
 // Author: <Miloš Đukarić, Florian Kerman, Stefan Jović>
 // ------------------------------------------------------------------------
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <iterator>
 #include "CommandHandler.hpp"
+#include "CommandSource.hpp"
+#include "CommandTokenizer.hpp"
 #include "Game.hpp"
+#include "RoundSchedule.hpp"
 
 using namespace std;
 
@@ -18,7 +23,7 @@ using namespace std;
 ///
 /// Constructs the Game object by loading configuration files and initializing the game state.
 ///
-/// This constructor loads all card definitions using the CardFactory, initializes the draw decks for
+/// This constructor loads all card definitions into a CardCatalog, initializes the draw decks for
 /// both players based on the configuration, assigns the decks to the players, and deals the initial
 /// hand of cards to each player. It also determines the initial roles (attacker/defender) based on
 /// round number.
@@ -29,9 +34,7 @@ using namespace std;
 Game::Game(const string &gameConfigPath, const string &messageConfigPath)
   : cfg(gameConfigPath),
     msgs(messageConfigPath),
-    factory(),
-    deck1(),
-    deck2(),
+    factory(CardCatalog::load()),
     p1(1, cfg.getPlayerHealth(), cfg.getManaPoolStart()),
     p2(2, cfg.getPlayerHealth(), cfg.getManaPoolStart()),
     board(),
@@ -44,21 +47,148 @@ Game::Game(const string &gameConfigPath, const string &messageConfigPath)
     result(GameResult::None),
     gameConfigPath(gameConfigPath)
 {
-  // 1) Load all creature and spell card definitions
-  factory.loadCreatureCards();
-  factory.loadSpellCards();
+  setupPlayers();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Constructs a Game from already parsed configuration objects. Used by batch simulation so the
+/// config and card data files are read once for many games. The result is not written back to any file.
+///
+/// @param config Parsed game configuration
+/// @param messages Parsed message configuration
+/// @param catalog Card definitions shared with other games
+//---------------------------------------------------------------------------------------------------------------------
+Game::Game(const GameConfigParser &config, const MessageConfigParser &messages,
+           shared_ptr<const CardCatalog> catalog)
+  : cfg(config),
+    msgs(messages),
+    factory(std::move(catalog)),
+    p1(1, cfg.getPlayerHealth(), cfg.getManaPoolStart()),
+    p2(2, cfg.getPlayerHealth(), cfg.getManaPoolStart()),
+    board(),
+    roundNumber(1),
+    currentPhase(Phase::Setup),
+    boardPrinting(true),
+    currentPlayerId(1),
+    attacker(nullptr),
+    defender(nullptr),
+    result(GameResult::None)
+{
+  setupPlayers();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Copies another game. The card holders of the copy refer to its own card pool.
+///
+/// @param other Game to copy
+//---------------------------------------------------------------------------------------------------------------------
+Game::Game(const Game &other)
+  : cfg(other.cfg),
+    msgs(other.msgs),
+    factory(other.factory),
+    p1(other.p1),
+    p2(other.p2),
+    board(other.board)
+{
+  copyState(other);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Replaces the state of this game with a copy of another game.
+///
+/// @param other Game to copy
+/// @return Game& Reference to this game
+//---------------------------------------------------------------------------------------------------------------------
+Game &Game::operator=(const Game &other)
+{
+  if (this != &other)
+  {
+    cfg = other.cfg;
+    msgs = other.msgs;
+    factory = other.factory;
+    p1 = other.p1;
+    p2 = other.p2;
+    board = other.board;
+    copyState(other);
+  }
+  return *this;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Copies the scalar state of another game and points the card holders and the attacker/defender
+/// pointers at this game's own pool and players. Shared by copy construction and assignment.
+///
+/// @param other Game to copy
+//---------------------------------------------------------------------------------------------------------------------
+void Game::copyState(const Game &other)
+{
+  doneCounter = other.doneCounter;
+  roundNumber = other.roundNumber;
+  currentPhase = other.currentPhase;
+  boardPrinting = other.boardPrinting;
+  currentPlayerId = other.currentPlayerId;
+  attacker = (other.attacker == &other.p1) ? &p1 : (other.attacker == &other.p2) ? &p2 : nullptr;
+  defender = (other.defender == &other.p1) ? &p1 : (other.defender == &other.p2) ? &p2 : nullptr;
+  result = other.result;
+  gameConfigPath = other.gameConfigPath;
+  sink = other.sink;
+  output = other.output;
+  gameOver = other.gameOver;
+  hash = other.hash;
+  fightsTaken = false;
+
+  journal.clear();
+  bindCardHolders();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Points the players, the board and the card pool at this game's card pool, undo journal and
+/// state hash.
+//---------------------------------------------------------------------------------------------------------------------
+void Game::bindCardHolders()
+{
+  p1.bindCardPool(factory.getPool());
+  p2.bindCardPool(factory.getPool());
+  board.bindCardPool(factory.getPool());
+
+  p1.bindUndoJournal(&journal);
+  p2.bindUndoJournal(&journal);
+  board.bindUndoJournal(&journal);
+  factory.getPool().bindUndoJournal(&journal);
+
+  p1.bindStateHash(&hash);
+  p2.bindStateHash(&hash);
+  board.bindStateHash(&hash);
+  factory.getPool().bindStateHash(&hash);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Builds both decks, deals the opening hands and sets the roles for round 1. Shared by both
+/// constructors.
+//---------------------------------------------------------------------------------------------------------------------
+void Game::setupPlayers()
+{
+  // 1) Card instances live in the factory's pool; bind the holders to it
+  bindCardHolders();
 
   // 2) Initialize each player's draw deck from config
-  deck1.loadFromIDs(cfg.getPlayer1Deck(), factory);
-  deck2.loadFromIDs(cfg.getPlayer2Deck(), factory);
+  p1.getDeck().loadFromIDs(cfg.getPlayer1Deck(), factory);
+  p2.getDeck().loadFromIDs(cfg.getPlayer2Deck(), factory);
 
-  // 3) Assign decks to player objects and draw initial 6 cards
-  p1.setDeck(deck1);
-  p2.setDeck(deck2);
+  // 3) Draw the initial hands
   p1.drawMultiple(7);
   p2.drawMultiple(7);
 
   updateRolesForNewRound();
+
+  // 4) Start the incremental hash from the complete state
+  hash.reset(cardHash());
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -72,18 +202,59 @@ Game::Game(const string &gameConfigPath, const string &messageConfigPath)
 /// @return int Exit status (0 = normal termination)
 //---------------------------------------------------------------------------------------------------------------------
 int Game::run()
+{
+  StreamCommandSource console(cin);
+  return run(console);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Runs the main game loop like run(), reading the commands from a source.
+///
+/// @param source Supplier of the command lines
+/// @return int Exit status (0 = normal termination)
+//---------------------------------------------------------------------------------------------------------------------
+int Game::run(CommandSource &source)
 {
   printWelcome(); // Welcome banner
   printBoard(); // Round header + board
   if (!isGameOver())
   {
-    promptPlayer(); // Only enter loop if game is still running
+    promptPlayer(source); // Only enter loop if game is still running
   }
+  sink->flush();
 
   writeResultToConfig();
   return 0;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Runs the game without any terminal I/O. Output goes to a NullOutputSink (every write is
+/// dropped before formatting) and the board is never rendered. Nothing is written to the config file.
+///
+/// @param source Supplier of the command lines
+/// @return Result of the game, GameResult::None if it did not finish
+//---------------------------------------------------------------------------------------------------------------------
+GameResult Game::simulate(CommandSource &source)
+{
+  // Puts the previous sink back however the game ends, also when a command throws
+  struct SinkGuard
+  {
+    Game &game;
+    OutputSink &previous;
+    ~SinkGuard() { game.setOutputSink(previous); }
+  };
+
+  NullOutputSink discard;
+  SinkGuard guard{*this, *sink};
+  setOutputSink(discard);
+  board.setPrinting(false);
+
+  promptPlayer(source);
+  return result;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 ///
 /// Returns the attacker player reference.
@@ -124,9 +295,9 @@ const Player &Game::getCurrentPlayer() const
 //---------------------------------------------------------------------------------------------------------------------
 void Game::printWelcome()
 {
-  cout << msgs.getMessage("D_BORDER_D");
-  cout << msgs.getMessage("D_WELCOME");
-  cout << msgs.getMessage("D_BORDER_D");
+  *output << msgs.getMessage(MessageKey::D_BORDER_D);
+  *output << msgs.getMessage(MessageKey::D_WELCOME);
+  *output << msgs.getMessage(MessageKey::D_BORDER_D);
   printRoundHeader();
 }
 
@@ -136,7 +307,7 @@ void Game::printWelcome()
 //---------------------------------------------------------------------------------------------------------------------
 void Game::printBoardWithP1OnBottom()
 {
-  board.print(roundNumber); // P1 is attacker (bottom)
+  board.print(roundNumber, *output); // P1 is attacker (bottom)
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -145,7 +316,7 @@ void Game::printBoardWithP1OnBottom()
 //---------------------------------------------------------------------------------------------------------------------
 void Game::printBoardWithP2OnBottom()
 {
-  board.print(roundNumber); // P2 is attacker (bottom)
+  board.print(roundNumber, *output); // P2 is attacker (bottom)
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -157,10 +328,7 @@ void Game::initRound()
   // Only print at the start of the round
   if (boardPrinting)
   {
-    if (roundNumber == 1 || roundNumber == 4 || roundNumber == 5 ||
-        roundNumber == 8 || roundNumber == 9 || roundNumber == 12 ||
-        roundNumber == 13 || roundNumber == 16 || roundNumber == 17 ||
-        roundNumber == 20 || roundNumber == 21 || roundNumber == 24)
+    if (isPlayer1AttackerRound(roundNumber))
     {
       printBoardWithP2OnBottom(); // P1 is attacker in round 1 (bottom)
     }
@@ -188,22 +356,22 @@ void Game::setCurrentPlayer(int id)
 //---------------------------------------------------------------------------------------------------------------------
 void Game::printRoundHeader()
 {
-  cout << "\n";
-  cout << msgs.getMessage("D_BORDER_D");
+  *output << "\n";
+  *output << msgs.getMessage(MessageKey::D_BORDER_D);
   // Centered label for current round number
-  cout << "                                         ROUND " << roundNumber
+  *output << "                                         ROUND " << roundNumber
       << "\n";
-  cout << msgs.getMessage("D_BORDER_D");
+  *output << msgs.getMessage(MessageKey::D_BORDER_D);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
 /// Begins the command input loop for the current player if the game is not yet over.
+///
+/// @param source Supplier of the command lines (console, script or bot)
 //---------------------------------------------------------------------------------------------------------------------
-void Game::promptPlayer()
+void Game::promptPlayer(CommandSource &source)
 {
-  string input;
-
   // TODO: Add all of the bollow here
   // There are three ways the game can end.
   // [ ] 1. A player has been reduced to zero health points or below. This
@@ -215,43 +383,94 @@ void Game::promptPlayer()
   // winner. If both players have the same amount of health points, the game
   // ends in a tie.
   //
-  if (p1.getDeckRemaining() == 0 || p2.getDeckRemaining() == 0)
+  if (endsWithEmptyDeck())
   {
-    cout << endl;
-    cout << msgs.getMessage("D_BORDER_GAME_END");
-    cout << msgs.getMessage("D_END_DRAW_CARD");
-    if (p1.getDeckRemaining() == 0)
-    {
-      cout << "Player 2 has won! Congratulations!\n";
-      result = GameResult::P2_Wins;
-    }
-    else
-    {
-      cout << "Player 1 has won! Congratulations!\n";
-      result = GameResult::P1_Wins;
-    }
-    cout << msgs.getMessage("D_BORDER_D");
     return;
   }
 
+  string input;
   while (!isGameOver())
   {
-    cout << "\nP" << getCurrentPlayer().getId() << "> ";
-    if (!getline(cin, input))
+    *output << "\nP" << getCurrentPlayer().getId() << "> ";
+    sink->flush(); // the only write to the terminal per command
+    if (!source.nextCommand(*this, input) || !playCommand(input))
     {
       break;
     }
+  }
+}
 
-    // Only exit the loop if CommandHandler::process returns false
-    if (!CommandHandler::process(input, *this))
-    {
-      break;
-    }
-    if (isGameOver())
-    {
-      break;
-    }
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Ends the game before the first command if a deck is empty: its player cannot draw and loses.
+///
+/// @return true if the game ended
+//---------------------------------------------------------------------------------------------------------------------
+bool Game::endsWithEmptyDeck()
+{
+  if (p1.getDeckRemaining() != 0 && p2.getDeckRemaining() != 0)
+  {
+    return false;
+  }
+  *output << "\n";
+  *output << msgs.getMessage(MessageKey::D_BORDER_GAME_END);
+  *output << msgs.getMessage(MessageKey::D_END_DRAW_CARD);
+  if (p1.getDeckRemaining() == 0)
+  {
+    *output << "Player 2 has won! Congratulations!\n";
+    result = GameResult::P2_Wins;
+  }
+  else
+  {
+    *output << "Player 1 has won! Congratulations!\n";
+    result = GameResult::P1_Wins;
   }
+  *output << msgs.getMessage(MessageKey::D_BORDER_D);
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Processes one command line; only CommandHandler::process returning false or the end of the game
+/// stops the game.
+///
+/// @param input Command line
+/// @return false if the game is over or was quit
+//---------------------------------------------------------------------------------------------------------------------
+bool Game::playCommand(const string &input)
+{
+  return CommandHandler::process(input, *this) && !isGameOver();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Sets up a headless game for playCommand() the way simulate() does, without taking a command
+/// source.
+///
+/// @param discard Sink for the messages
+/// @return false if a deck is empty and the game is already over
+//---------------------------------------------------------------------------------------------------------------------
+bool Game::startHeadless(NullOutputSink &discard)
+{
+  setOutputSink(discard);
+  board.setPrinting(false);
+  return !endsWithEmptyDeck();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// A battle phase follows the second "done" of a round, which is the only "done" while one player
+/// has already ended their turn.
+///
+/// @param input Command line
+/// @return true if the command is a valid "done" and the other player is done already
+//---------------------------------------------------------------------------------------------------------------------
+bool Game::startsBattle(const string &input) const
+{
+  if (doneCounter != 1) return false;
+  Command command;
+  return parseCommand(tokenizeCommand(input), factory.getCatalog(), command) == CommandStatus::Ok &&
+         command.verb == Verb::Done;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -264,8 +483,8 @@ void Game::incrementRound()
 
   if (roundNumber > cfg.getMaxRounds())
   {
-    cout << "\n" << msgs.getMessage("D_BORDER_GAME_END");
-    cout << msgs.getMessage("D_END_MAX_ROUNDS");
+    *output << "\n" << msgs.getMessage(MessageKey::D_BORDER_GAME_END);
+    *output << msgs.getMessage(MessageKey::D_END_MAX_ROUNDS);
 
     int hp1 = p1.getHealth();
     int hp2 = p2.getHealth();
@@ -276,39 +495,41 @@ void Game::incrementRound()
 
     if (hp1 > hp2)
     {
-      cout << "Player 1 has won! Congratulations!\n";
+      *output << "Player 1 has won! Congratulations!\n";
     }
     else if (hp2 > hp1)
     {
-      cout << "Player 2 has won! Congratulations!\n";
+      *output << "Player 2 has won! Congratulations!\n";
     }
     else
     {
-      cout << msgs.getMessage("D_TIE");
+      *output << msgs.getMessage(MessageKey::D_TIE);
     }
 
-    cout << msgs.getMessage("D_BORDER_D");
+    *output << msgs.getMessage(MessageKey::D_BORDER_D);
     endGame();
     return;
   }
   if (p1.getDeckRemaining() == 0 || p2.getDeckRemaining() == 0)
   {
     printRoundHeader();
-    cout << "\n" << msgs.getMessage("D_BORDER_GAME_END");
-    cout << msgs.getMessage("D_END_DRAW_CARD");
+    *output << "\n" << msgs.getMessage(MessageKey::D_BORDER_GAME_END);
+    *output << msgs.getMessage(MessageKey::D_END_DRAW_CARD);
 
     int currentId = getCurrentPlayer().getId();
 
     if (getCurrentPlayer().getDeckRemaining() == 0)
     {
-      cout << "Player " << getOpponentPlayer().getId() << " has won! Congratulations!" << endl;
+      result = (getOpponentPlayer().getId() == 1) ? GameResult::P1_Wins : GameResult::P2_Wins;
+      *output << "Player " << getOpponentPlayer().getId() << " has won! Congratulations!" << "\n";
     }
     else
     {
-      cout << "Player " << currentId << " has won! Congratulations!" << endl;
+      result = (currentId == 1) ? GameResult::P1_Wins : GameResult::P2_Wins;
+      *output << "Player " << currentId << " has won! Congratulations!" << "\n";
     }
 
-    cout << msgs.getMessage("D_BORDER_D");
+    *output << msgs.getMessage(MessageKey::D_BORDER_D);
     endGame();
     return;
   }
@@ -332,10 +553,7 @@ void Game::incrementRound()
 //--------------------------------------------------------------------------------------------------------------------
 void Game::updateRolesForNewRound()
 {
-  if (roundNumber == 1 || roundNumber == 4 || roundNumber == 5 ||
-      roundNumber == 8 || roundNumber == 9 || roundNumber == 12 ||
-      roundNumber == 13 || roundNumber == 16 || roundNumber == 17 ||
-      roundNumber == 20 || roundNumber == 21 || roundNumber == 24)
+  if (isPlayer1AttackerRound(roundNumber))
   {
     setAttacker(p1);
     setDefender(p2);
@@ -362,11 +580,11 @@ void Game::printBoard()
   // Flip layout only on even-numbered rounds
   if (roundNumber % 2 == 0)
   {
-    board.print(roundNumber); // P1 on top
+    board.print(roundNumber, *output); // P1 on top
   }
   else
   {
-    board.print(roundNumber); // P2 on top
+    board.print(roundNumber, *output); // P2 on top
   }
 }
 
@@ -380,7 +598,7 @@ void Game::printBoard()
 bool Game::handleDirectHit(int damage)
 {
   defender->setHealth(defender->getHealth() - damage);
-  cout << msgs.getMessage("I_DIRECT");
+  *output << msgs.getMessage(MessageKey::I_DIRECT);
 
   if (defender->getHealth() <= 0)
   {
@@ -393,10 +611,10 @@ bool Game::handleDirectHit(int damage)
       result = GameResult::P2_Wins;
     }
 
-    cout << "\n" << msgs.getMessage("D_BORDER_GAME_END");
-    cout << msgs.getMessage("D_END_PLAYER_DEFEATED");
-    cout << "Player " << attacker->getId() << " has won! Congratulations!\n";
-    cout << msgs.getMessage("D_BORDER_D");
+    *output << "\n" << msgs.getMessage(MessageKey::D_BORDER_GAME_END);
+    *output << msgs.getMessage(MessageKey::D_END_PLAYER_DEFEATED);
+    *output << "Player " << attacker->getId() << " has won! Congratulations!\n";
+    *output << msgs.getMessage(MessageKey::D_BORDER_D);
     endGame();
 
     return true; // game is over
@@ -414,7 +632,7 @@ bool Game::handleDirectHit(int damage)
 bool Game::handleDirectHitToAttacker(int damage)
 {
   attacker->setHealth(attacker->getHealth() - damage);
-  cout << msgs.getMessage("I_DIRECT");
+  *output << msgs.getMessage(MessageKey::I_DIRECT);
 
   if (attacker->getHealth() <= 0)
   {
@@ -427,10 +645,10 @@ bool Game::handleDirectHitToAttacker(int damage)
       result = GameResult::P2_Wins;
     }
 
-    cout << "\n" << msgs.getMessage("D_BORDER_GAME_END");
-    cout << msgs.getMessage("D_END_PLAYER_DEFEATED");
-    cout << "Player " << defender->getId() << " has won! Congratulations!\n";
-    cout << msgs.getMessage("D_BORDER_D");
+    *output << "\n" << msgs.getMessage(MessageKey::D_BORDER_GAME_END);
+    *output << msgs.getMessage(MessageKey::D_END_PLAYER_DEFEATED);
+    *output << "Player " << defender->getId() << " has won! Congratulations!\n";
+    *output << msgs.getMessage(MessageKey::D_BORDER_D);
     endGame();
 
     return true; // game is over
@@ -463,11 +681,99 @@ Player &Game::getPlayerById(int id)
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
-/// Processes the entire battle phase logic including traits and damage resolution.
+/// Prepares the fights of all battle slots for being resolved up front, for a battle phase whose
+/// output is discarded. The fights share no creatures and the rest of the battle phase only changes
+/// player health, so the results stay valid until each slot is reached. Fights of unchanged
+/// creatures come from the catalog's fight table; the others are added to the batch.
+///
+/// @param batch Batch receiving the fights that are not in the table
+//---------------------------------------------------------------------------------------------------------------------
+void Game::queueFights(FightBatch &batch)
+{
+  const CardPool &pool = factory.getPool();
+  const FightTable &fights = factory.getCatalog().getFightTable();
+  const Zone &attackerBattle = (attacker->getId() == 1) ? board.attackerBattle() : board.defenderBattle();
+  const Zone &defenderBattle = (defender->getId() == 1) ? board.attackerBattle() : board.defenderBattle();
+
+  for (int i = 0; i < 7; ++i)
+  {
+    hasBattleOutcome[i] = false;
+    battleLanes[i] = -1;
+    const CreatureCard *attackerCreature = pool.getCreature(attackerBattle.getHandle(i));
+    const CreatureCard *defenderCreature = pool.getCreature(defenderBattle.getHandle(i));
+    if (!attackerCreature || !defenderCreature) continue;
+
+    FightStats attackerStats{attackerCreature->getAttack(), attackerCreature->getHealth(),
+                             attackerCreature->getBaseHP(), attackerCreature->getTraits()};
+    FightStats defenderStats{defenderCreature->getAttack(), defenderCreature->getHealth(),
+                             defenderCreature->getBaseHP(), defenderCreature->getTraits()};
+    int attackerProfile = fights.profile(attackerCreature->getKind(), attackerStats.attack, attackerStats.health,
+                                         attackerStats.baseHealth, attackerStats.traits);
+    int defenderProfile = fights.profile(defenderCreature->getKind(), defenderStats.attack, defenderStats.health,
+                                         defenderStats.baseHealth, defenderStats.traits);
+    if (attackerProfile != FightTable::NO_PROFILE && defenderProfile != FightTable::NO_PROFILE)
+    {
+      battleOutcomes[i] = fights.outcome(attackerProfile, defenderProfile);
+      hasBattleOutcome[i] = true;
+    }
+    else if (batch.add(attackerStats, defenderStats))
+    {
+      battleLanes[i] = static_cast<int>(batch.size()) - 1;
+    }
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Collects the outcomes of the lanes added by queueFights() for the next battle phase. Slots
+/// without an outcome (no fight, or stats the batch rejects) take the general path.
+///
+/// @param batch The resolved batch
+//---------------------------------------------------------------------------------------------------------------------
+void Game::takeFights(const FightBatch &batch)
+{
+  for (int i = 0; i < 7; ++i)
+  {
+    if (battleLanes[i] < 0) continue;
+    battleOutcomes[i] = batch.outcome(battleLanes[i]);
+    hasBattleOutcome[i] = true;
+  }
+  fightsTaken = true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Applies the outcome of a fight to both creatures and players.
+///
+/// @param attackerCreature Battle creature of the attacker
+/// @param defenderCreature Battle creature of the defender in the same slot
+/// @param outcome          Outcome of their fight
+//---------------------------------------------------------------------------------------------------------------------
+void Game::applyFight(CreatureCard &attackerCreature, CreatureCard &defenderCreature, const FightOutcome &outcome)
+{
+  attackerCreature.takeDamage(attackerCreature.getHealth() - outcome.attackerHealth);
+  defenderCreature.takeDamage(defenderCreature.getHealth() - outcome.defenderHealth);
+  if (outcome.attackerPoisoned) attackerCreature.addTrait(Trait::Poisoned);
+  if (outcome.defenderPoisoned) defenderCreature.addTrait(Trait::Poisoned);
+  for (int16_t change: outcome.attackerPlayer)
+  {
+    if (change != 0) attacker->setHealth(attacker->getHealth() + change);
+  }
+  for (int16_t change: outcome.defenderPlayer)
+  {
+    if (change != 0) defender->setHealth(defender->getHealth() + change);
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Processes the entire battle phase logic including traits and damage resolution. While the output
+/// is discarded, the fights are resolved up front: by the caller through queueFights() and
+/// takeFights(), or here in the game's own batch.
 //---------------------------------------------------------------------------------------------------------------------
 void Game::processBattlePhase()
 {
-  cout << "\n" << msgs.getMessage("D_BORDER_BATTLE_PHASE");
+  *output << "\n" << msgs.getMessage(MessageKey::D_BORDER_BATTLE_PHASE);
 
   Zone &attackerBattle = (attacker->getId() == 1)
                            ? board.attackerBattle()
@@ -476,6 +782,19 @@ void Game::processBattlePhase()
                            ? board.attackerBattle()
                            : board.defenderBattle();
 
+  if (!fightsTaken)
+  {
+    fill(begin(hasBattleOutcome), end(hasBattleOutcome), false);
+    if (sink->discards())
+    {
+      fightBatch.clear();
+      queueFights(fightBatch);
+      fightBatch.resolve();
+      takeFights(fightBatch);
+    }
+  }
+  fightsTaken = false;
+
   /*checks if the game should end*/
   bool gameShouldEnd = false;
   int winnerId = 0;
@@ -485,10 +804,11 @@ void Game::processBattlePhase()
   {
     if (p1.getHealth() <= 0 && p2.getHealth() <= 0)
     {
-      cout << "\n" << msgs.getMessage("D_BORDER_GAME_END");
-      cout << msgs.getMessage("D_END_PLAYER_DEFEATED");
-      cout << msgs.getMessage("D_TIE");
-      cout << msgs.getMessage("D_BORDER_D");
+      result = GameResult::Tie;
+      *output << "\n" << msgs.getMessage(MessageKey::D_BORDER_GAME_END);
+      *output << msgs.getMessage(MessageKey::D_END_PLAYER_DEFEATED);
+      *output << msgs.getMessage(MessageKey::D_TIE);
+      *output << msgs.getMessage(MessageKey::D_BORDER_D);
       endGame();
       return;
     }
@@ -498,8 +818,8 @@ void Game::processBattlePhase()
       return;
     }
 
-    cout << "---------------------------------------- SLOT " << (i + 1)
-        << " -----------------------------------------" << endl;
+    *output << "---------------------------------------- SLOT " << (i + 1)
+        << " -----------------------------------------" << "\n";
 
 
     Card *atkCard = attackerBattle.getCard(i);
@@ -547,7 +867,12 @@ void Game::processBattlePhase()
 
     /*Attack 1 starts */
     CreatureCard *defenderCreature = static_cast<CreatureCard *>(defCard);
-    cout << msgs.getMessage("I_FIGHT");
+    if (hasBattleOutcome[i])
+    {
+      applyFight(*attackerCreature, *defenderCreature, battleOutcomes[i]);
+      continue;
+    }
+    *output << msgs.getMessage(MessageKey::I_FIGHT);
 
     int defBeforeHP = defenderCreature->getHealth();
 
@@ -564,8 +889,8 @@ void Game::processBattlePhase()
     /* First strike handling */
     if (attackerFirstStrike ^ defenderFirstStrike)
     {
-      cout << msgs.getMessage("D_ATTACK_1");
-      cout << msgs.getMessage("I_FIRST_STRIKE");
+      *output << msgs.getMessage(MessageKey::D_ATTACK_1);
+      *output << msgs.getMessage(MessageKey::I_FIRST_STRIKE);
 
       if (attackerFirstStrike)
       {
@@ -583,7 +908,7 @@ void Game::processBattlePhase()
         if (attackerBrutal)
         {
           attackerDamage += 1;
-          cout << msgs.getMessage("I_BRUTAL");
+          *output << msgs.getMessage(MessageKey::I_BRUTAL);
         }
 
         if (defenderCreature->getHealth() <= 0)
@@ -595,21 +920,21 @@ void Game::processBattlePhase()
         if (defenderCreature->getHealth() > 0 && attackerCreature->hasTrait(Trait::Poisoned))
         {
           defenderCreature->addTrait(Trait::Poisoned);
-          cout << msgs.getMessage("I_POISONED") << endl;
+          *output << msgs.getMessage(MessageKey::I_POISONED) << "\n";
         }
 
         /* venomous trait */
         if (defenderCreature->getHealth() > 0 && attackerCreature->hasTrait(Trait::Venomous))
         {
           defenderCreature->addTrait(Trait::Poisoned);
-          cout << msgs.getMessage("I_VENOMOUS");
+          *output << msgs.getMessage(MessageKey::I_VENOMOUS);
         }
 
         /* lifesteal handling */
         if (attackerCreature->hasTrait(Trait::Lifesteal))
         {
           attacker->setHealth(attacker->getHealth() + attackerDamage);
-          cout << msgs.getMessage("I_LIFESTEAL");
+          *output << msgs.getMessage(MessageKey::I_LIFESTEAL);
         }
 
         /* --- ATTACK 2 BEGINS */
@@ -617,7 +942,7 @@ void Game::processBattlePhase()
 
         if (defenderCreature->getHealth() > 0)
         {
-          cout << msgs.getMessage("D_ATTACK_2");
+          *output << msgs.getMessage(MessageKey::D_ATTACK_2);
 
           attackerCreature->takeDamage(defenderDamage);
 
@@ -633,7 +958,7 @@ void Game::processBattlePhase()
           if (defenderBrutal)
           {
             defenderDamage += 1;
-            cout << msgs.getMessage("I_BRUTAL");
+            *output << msgs.getMessage(MessageKey::I_BRUTAL);
           }
 
           if (attackerCreature->getHealth() <= 0)
@@ -645,21 +970,21 @@ void Game::processBattlePhase()
           if (attackerCreature->getHealth() > 0 && defenderCreature->hasTrait(Trait::Poisoned))
           {
             attackerCreature->addTrait(Trait::Poisoned);
-            cout << msgs.getMessage("I_POISONED") << endl;
+            *output << msgs.getMessage(MessageKey::I_POISONED) << "\n";
           }
 
           /* venomous trait */
           if (attackerCreature->getHealth() > 0 && defenderCreature->hasTrait(Trait::Venomous))
           {
             attackerCreature->addTrait(Trait::Poisoned);
-            cout << msgs.getMessage("I_VENOMOUS");
+            *output << msgs.getMessage(MessageKey::I_VENOMOUS);
           }
 
           /* lifesteal handling*/
           if (defenderCreature->hasTrait(Trait::Lifesteal))
           {
             defender->setHealth(defender->getHealth() + defenderDamage);
-            cout << msgs.getMessage("I_LIFESTEAL");
+            *output << msgs.getMessage(MessageKey::I_LIFESTEAL);
           }
         }
       }
@@ -677,7 +1002,7 @@ void Game::processBattlePhase()
         if (defenderBrutal)
         {
           defenderDamage += 1;
-          cout << msgs.getMessage("I_BRUTAL");
+          *output << msgs.getMessage(MessageKey::I_BRUTAL);
         }
 
         /* poisioned trait */
@@ -685,7 +1010,7 @@ void Game::processBattlePhase()
             defenderCreature->hasTrait(Trait::Poisoned))
         {
           attackerCreature->addTrait(Trait::Poisoned);
-          cout << msgs.getMessage("I_POISONED") << endl;
+          *output << msgs.getMessage(MessageKey::I_POISONED) << "\n";
         }
 
         /* venomous trait */
@@ -693,20 +1018,20 @@ void Game::processBattlePhase()
             defenderCreature->hasTrait(Trait::Venomous))
         {
           attackerCreature->addTrait(Trait::Poisoned);
-          cout << msgs.getMessage("I_VENOMOUS");
+          *output << msgs.getMessage(MessageKey::I_VENOMOUS);
         }
 
         /* lifesteal handling */
         if (defenderCreature->hasTrait(Trait::Lifesteal))
         {
           defender->setHealth(defender->getHealth() + defenderDamage);
-          cout << msgs.getMessage("I_LIFESTEAL") << endl;
+          *output << msgs.getMessage(MessageKey::I_LIFESTEAL) << "\n";
         }
 
         /* ----ATTACK 2 BEGINS ----*/
         if (attackerCreature->getHealth() > 0)
         {
-          cout << msgs.getMessage("D_ATTACK_2");
+          *output << msgs.getMessage(MessageKey::D_ATTACK_2);
 
           defenderCreature->takeDamage(attackerDamage);
 
@@ -719,7 +1044,7 @@ void Game::processBattlePhase()
           if (attackerBrutal)
           {
             attackerDamage += 1;
-            cout << msgs.getMessage("I_BRUTAL");
+            *output << msgs.getMessage(MessageKey::I_BRUTAL);
           }
 
           /* poisioned trait handling */
@@ -727,21 +1052,21 @@ void Game::processBattlePhase()
               attackerCreature->hasTrait(Trait::Poisoned))
           {
             defenderCreature->addTrait(Trait::Poisoned);
-            cout << msgs.getMessage("I_POISONED") << endl;
+            *output << msgs.getMessage(MessageKey::I_POISONED) << "\n";
           }
           /* venomous trait handling */
           if (defenderCreature->getHealth() > 0 &&
               attackerCreature->hasTrait(Trait::Venomous))
           {
             defenderCreature->addTrait(Trait::Poisoned);
-            cout << msgs.getMessage("I_VENOMOUS");
+            *output << msgs.getMessage(MessageKey::I_VENOMOUS);
           }
 
           /* lifesteal handling */
           if (attackerCreature->hasTrait(Trait::Lifesteal))
           {
             attacker->setHealth(attacker->getHealth() + attackerDamage);
-            cout << msgs.getMessage("I_LIFESTEAL");
+            *output << msgs.getMessage(MessageKey::I_LIFESTEAL);
           }
         }
       }
@@ -750,7 +1075,7 @@ void Game::processBattlePhase()
     else
     {
       // --- ATTACK 1 ---
-      cout << msgs.getMessage("D_ATTACK_1");
+      *output << msgs.getMessage(MessageKey::D_ATTACK_1);
 
       defenderCreature->takeDamage(attackerDamage);
 
@@ -763,7 +1088,7 @@ void Game::processBattlePhase()
       if (attackerBrutal)
       {
         attackerDamage += 1;
-        cout << msgs.getMessage("I_BRUTAL");
+        *output << msgs.getMessage(MessageKey::I_BRUTAL);
       }
 
       /* poisioned trait */
@@ -771,7 +1096,7 @@ void Game::processBattlePhase()
           attackerCreature->hasTrait(Trait::Poisoned))
       {
         defenderCreature->addTrait(Trait::Poisoned);
-        cout << msgs.getMessage("I_POISONED") << endl;
+        *output << msgs.getMessage(MessageKey::I_POISONED) << "\n";
       }
 
       /* venomous trait handling */
@@ -779,18 +1104,18 @@ void Game::processBattlePhase()
           attackerCreature->hasTrait(Trait::Venomous))
       {
         defenderCreature->addTrait(Trait::Poisoned);
-        cout << msgs.getMessage("I_VENOMOUS");
+        *output << msgs.getMessage(MessageKey::I_VENOMOUS);
       }
 
       /* lifesteal handling */
       if (attackerCreature->hasTrait(Trait::Lifesteal))
       {
         attacker->setHealth(attacker->getHealth() + attackerDamage);
-        cout << msgs.getMessage("I_LIFESTEAL");
+        *output << msgs.getMessage(MessageKey::I_LIFESTEAL);
       }
 
       // --- ATTACK 2 ---
-      cout << msgs.getMessage("D_ATTACK_2");
+      *output << msgs.getMessage(MessageKey::D_ATTACK_2);
 
       attackerCreature->takeDamage(defenderDamage);
 
@@ -803,7 +1128,7 @@ void Game::processBattlePhase()
       if (defenderBrutal)
       {
         defenderDamage += 1;
-        cout << msgs.getMessage("I_BRUTAL");
+        *output << msgs.getMessage(MessageKey::I_BRUTAL);
       }
 
       /* posioned trait */
@@ -811,21 +1136,21 @@ void Game::processBattlePhase()
           defenderCreature->hasTrait(Trait::Poisoned))
       {
         attackerCreature->addTrait(Trait::Poisoned);
-        cout << msgs.getMessage("I_POISONED") << endl;
+        *output << msgs.getMessage(MessageKey::I_POISONED) << "\n";
       }
 
       /* venomous trait */
       if (defenderCreature->hasTrait(Trait::Venomous))
       {
         attackerCreature->addTrait(Trait::Poisoned);
-        cout << msgs.getMessage("I_VENOMOUS");
+        *output << msgs.getMessage(MessageKey::I_VENOMOUS);
       }
 
       /* lifesteal handling */
       if (defenderCreature->hasTrait(Trait::Lifesteal))
       {
         defender->setHealth(defender->getHealth() + defenderDamage);
-        cout << msgs.getMessage("I_LIFESTEAL");
+        *output << msgs.getMessage(MessageKey::I_LIFESTEAL);
       }
     }
   }
@@ -844,8 +1169,8 @@ void Game::processBattlePhase()
       // if (rawCreature->isResurrected()) continue;
 
 
-      shared_ptr<Card> movingCard = battleZone.extractCard(i);
-      CreatureCard *creature = dynamic_cast<CreatureCard *>(movingCard.get());
+      CardHandle movingCard = battleZone.extractCard(i);
+      CreatureCard *creature = factory.getPool().getCreature(movingCard);
 
 
       if (!creature) continue;
@@ -856,17 +1181,17 @@ void Game::processBattlePhase()
         if (creature->hasTrait(Trait::Regenerate))
         {
           creature->setHealth(creature->getBaseHP());
-          cout << msgs.getMessage("I_REGENERATE");
+          *output << msgs.getMessage(MessageKey::I_REGENERATE);
         }
         else if (creature->hasTrait(Trait::Undying))
         {
           creature->resetStats(); // <== resets stats / health and so on
           creature->removeTrait(Trait::Undying); // <== removes the trait
           creature->markResurrected(); // <== prevent re-processing
-          cout << msgs.getMessage("I_UNDYING");
+          *output << msgs.getMessage(MessageKey::I_UNDYING);
 
 
-          owner->removeFromGraveyard(std::dynamic_pointer_cast<CreatureCard>(movingCard));
+          owner->removeFromGraveyard(movingCard);
           // === Try placing creature back to field immediately
           bool placed = false;
           for (int j = 0; j < 7; ++j)
@@ -881,7 +1206,7 @@ void Game::processBattlePhase()
 
           if (!placed)
           {
-            owner->addToGraveyard(std::dynamic_pointer_cast<CreatureCard>(movingCard));
+            owner->addToGraveyard(movingCard);
             // <== if there is no place send it to the graveyard
           }
 
@@ -889,7 +1214,7 @@ void Game::processBattlePhase()
         }
         else
         {
-          owner->addToGraveyard(std::dynamic_pointer_cast<CreatureCard>(movingCard));
+          owner->addToGraveyard(movingCard);
           continue; // Skip placing on field
         }
       }
@@ -908,7 +1233,7 @@ void Game::processBattlePhase()
 
       if (!placed)
       {
-        owner->addToGraveyard(std::dynamic_pointer_cast<CreatureCard>(movingCard));
+        owner->addToGraveyard(movingCard);
       }
     }
   };
@@ -922,9 +1247,8 @@ void Game::processBattlePhase()
       if (!creature) continue;
       if (creature->hasTrait(Trait::Temporary))
       {
-        cout << msgs.getMessage("I_TEMPORARY");
-        shared_ptr<Card> removed = fieldZone.extractCard(i);
-        player->addToGraveyard(std::dynamic_pointer_cast<CreatureCard>(removed));
+        *output << msgs.getMessage(MessageKey::I_TEMPORARY);
+        player->addToGraveyard(fieldZone.extractCard(i));
       }
     }
   };
@@ -933,19 +1257,20 @@ void Game::processBattlePhase()
   {
     Zone &fieldZone =
         (player->getId() == 1) ? board.attackerField() : board.defenderField();
-    std::vector<std::shared_ptr<CreatureCard> > resurrected;
-    for (const auto &card: player->getGraveyard())
+    std::vector<CardHandle> resurrected;
+    for (CardHandle handle: player->getGraveyard())
     {
+      CreatureCard *card = factory.getPool().getCreature(handle);
       if (card->hasTrait(Trait::Undying))
       {
-        cout << msgs.getMessage("I_UNDYING");
+        *output << msgs.getMessage(MessageKey::I_UNDYING);
         card->resetStats();
         card->removeTrait(Trait::Undying);
-        resurrected.push_back(card);
+        resurrected.push_back(handle);
       }
     }
 
-    for (const auto &card: resurrected)
+    for (CardHandle card: resurrected)
     {
       bool placed = false;
       for (int j = 0; j < 7; ++j)
@@ -970,7 +1295,7 @@ void Game::processBattlePhase()
       (attacker->getId() == 1) ? board.attackerField() : board.defenderField();
   Zone &field2 =
       (defender->getId() == 1) ? board.attackerField() : board.defenderField();
-  cout << msgs.getMessage("D_BORDER_BATTLE_END");
+  *output << msgs.getMessage(MessageKey::D_BORDER_BATTLE_END);
 
 
   returnBattleToFieldZone(attackerBattle, field1, attacker);
@@ -986,16 +1311,16 @@ void Game::processBattlePhase()
   // in the case where game is over it prints out ending part
   if (gameShouldEnd)
   {
-    cout << "\n" << msgs.getMessage("D_BORDER_GAME_END");
+    *output << "\n" << msgs.getMessage(MessageKey::D_BORDER_GAME_END);
     if (winnerId == 0)
     {
-      cout << msgs.getMessage("D_TIE");
+      *output << msgs.getMessage(MessageKey::D_TIE);
     }
     else
     {
-      cout << "Player " << winnerId << " has won! Congratulations!\n";
+      *output << "Player " << winnerId << " has won! Congratulations!\n";
     }
-    cout << msgs.getMessage("D_BORDER_D");
+    *output << msgs.getMessage(MessageKey::D_BORDER_D);
     endGame();
     return;
   }
@@ -1007,10 +1332,15 @@ void Game::processBattlePhase()
 //---------------------------------------------------------------------------------------------------------------------
 void Game::writeResultToConfig()
 {
+  if (gameConfigPath.empty())
+  {
+    return; // game was built from parsed configs, there is no file to append to
+  }
+
   std::ofstream out(gameConfigPath, std::ios::app);
   if (!out.is_open())
   {
-    std::cout << "<I_FILE_WRITE_FAILED>\n";
+    *output << "<I_FILE_WRITE_FAILED>\n";
     return;
   }
 
@@ -10,12 +10,21 @@
 #pragma once
 
 #include <string>
+#include <iostream>
 #include "ConfigParser.hpp"
 #include "MessageConfigParser.hpp"
 #include "CardFactory.hpp"
 #include "Deck.hpp"
 #include "Player.hpp"
 #include "Board.hpp"
+#include "OutputSink.hpp"
+#include "Command.hpp"
+#include "UndoJournal.hpp"
+#include "GameState.hpp"
+#include "StateHash.hpp"
+#include "FightBatch.hpp"
+
+class CommandSource;
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
@@ -73,6 +82,40 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   Game(const std::string &gameConfigPath, const std::string &messageConfigPath);
 
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Constructor: initializes game from already parsed configs, so batch runs parse the files once.
+  /// Games created this way have no config file to append the result to.
+  ///
+  /// @param config Parsed GAME config
+  /// @param messages Parsed MESSAGE config
+  /// @param catalog Card definitions, shared read-only between games
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  Game(const GameConfigParser &config, const MessageConfigParser &messages,
+       std::shared_ptr<const CardCatalog> catalog);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Copy constructor: creates an independent copy of the game state (cards, players, board, round)
+  /// that writes to the same output sink. Used by searches that try moves on a copy.
+  ///
+  /// @param other Game to copy
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  Game(const Game &other);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Copy assignment: replaces the state of this game with a copy of another game's state.
+  ///
+  /// @param other Game to copy
+  ///
+  /// @return Reference to this game
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  Game &operator=(const Game &other);
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Runs the main game loop.
@@ -82,6 +125,118 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   int run();
 
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Runs the main game loop with commands from the given source instead of the terminal, e.g. a
+  /// SeatedCommandSource that lets a bot play one seat.
+  ///
+  /// @param source Supplier of the command lines
+  ///
+  /// @return 0 on normal game quit
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  int run(CommandSource &source);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Plays the game headless: no welcome text, no board rendering, all messages discarded and no
+  /// result appended to the config file. Commands are pulled from the given source until the game
+  /// ends or the source is exhausted.
+  ///
+  /// @param source Supplier of the command lines (script or bot)
+  ///
+  /// @return Result of the game (GameResult::None if it was quit or the source ran dry)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  GameResult simulate(CommandSource &source);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Prepares a headless game that is driven one command at a time by playCommand() (see the
+  /// LockstepSimulator) instead of simulate(): discards the messages and turns board rendering off.
+  ///
+  /// @param discard Sink for the messages; must outlive the game
+  ///
+  /// @return false if the game is already over because a deck is empty
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool startHeadless(NullOutputSink &discard);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Processes one command line like the prompt loop does.
+  ///
+  /// @param input Command line
+  ///
+  /// @return false if the game is over or the command quit it
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool playCommand(const std::string &input);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Checks whether a command line is the "done" that ends the round, i.e. runs the battle phase.
+  ///
+  /// @param input Command line
+  ///
+  /// @return true if playing the command starts the battle phase
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool startsBattle(const std::string &input) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Adds the fights of the coming battle phase to a batch shared with other games. Fights found in
+  /// the catalog's fight table are looked up instead. Only the "done" that starts the battle may be
+  /// played between this and takeFights(); it changes the fields, not the battle zones.
+  ///
+  /// @param batch Batch collecting the fights of many games
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void queueFights(FightBatch &batch);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Takes the outcomes of the fights added by queueFights() from the resolved batch. The next
+  /// battle phase applies them instead of resolving the fights itself.
+  ///
+  /// @param batch The batch passed to queueFights(), resolved
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void takeFights(const FightBatch &batch);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Returns the result of the game so far.
+  ///
+  /// @return GameResult::None while the game is running
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  GameResult getResult() const { return result; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Returns the stream all game output is written to (the console sink unless redirected).
+  ///
+  /// @return Reference to the output stream of the current sink
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  std::ostream &getOutput() { return *output; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Redirects all game output to the given sink. The sink is flushed whenever the game waits for
+  /// a command and when run() returns.
+  ///
+  /// @param newSink Sink to write to (must outlive its use by the game)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void setOutputSink(OutputSink &newSink)
+  {
+    sink = &newSink;
+    output = &newSink.stream();
+  }
+
   int doneCounter = 0;
 
   //---------------------------------------------------------------------------------------------------------------------
@@ -93,6 +248,13 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   Player &getPlayer1() { return p1; }
 
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Read-only reference to player 1
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  const Player &getPlayer1() const { return p1; }
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Returns reference to Player 2.
@@ -102,6 +264,13 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   Player &getPlayer2() { return p2; }
 
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Read-only reference to player 2
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  const Player &getPlayer2() const { return p2; }
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Returns reference to the current player.
@@ -120,6 +289,8 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   Player &getOpponentPlayer() { return (currentPlayerId == 1) ? p2 : p1; }
 
+  const Player &getOpponentPlayer() const { return (currentPlayerId == 1) ? p2 : p1; }
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Switches current player from 1 to 2 or vice versa.
@@ -136,6 +307,8 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   GameConfigParser &getConfig() { return cfg; }
 
+  const GameConfigParser &getConfig() const { return cfg; }
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Returns const reference to message config.
@@ -163,6 +336,8 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   CardFactory &getCardFactory() { return factory; }
 
+  const CardFactory &getCardFactory() const { return factory; }
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Returns reference to the game board.
@@ -172,6 +347,8 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   Board &getBoard() { return board; }
 
+  const Board &getBoard() const { return board; }
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Checks whether board printing is enabled.
@@ -408,11 +585,99 @@ public:
   //---------------------------------------------------------------------------------------------------------------------e
   Player &getPlayerById(int id);
 
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Executes an action (done, creature, battle, redraw, spell) for the current player without
+  /// any text parsing. Info messages of the action are written to the output sink; errors are
+  /// only returned.
+  ///
+  /// @param command Action to execute
+  ///
+  /// @return CommandStatus::Ok, or why the action was rejected (nothing changed in that case)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  CommandStatus apply(const Command &command);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Executes an action like apply() and records every change it makes, so unmakeMove() can revert
+  /// it in O(changes) instead of copying the game. Moves nest: each successful makeMove needs one
+  /// unmakeMove, in reverse order. Output is still written to the sink (use a NullOutputSink).
+  ///
+  /// @param command Action to execute
+  ///
+  /// @return CommandStatus::Ok, or why the action was rejected (nothing to unmake in that case)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  CommandStatus makeMove(const Command &command);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Reverts the most recent successful makeMove().
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void unmakeMove();
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Writes the complete mutable state of the game (players, cards, board, round and turn) into a
+  /// flat snapshot.
+  ///
+  /// @param state Receives the snapshot
+  ///
+  /// @return false if the game has created more than MAX_STATE_CARDS (96) card instances, or a
+  ///         creature's attack or health does not fit 16 bits (state is undefined then)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool saveState(GameState &state) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Replaces the mutable state of the game with a snapshot taken from a game with the same
+  /// configuration. Moves made with makeMove can no longer be unmade afterwards.
+  ///
+  /// @param state Snapshot written by saveState
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void loadState(const GameState &state);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Replaces what a player cannot see with one random possibility: the order of both decks and the
+  /// opponent's hand, which is dealt from the opponent's hand and deck together. Cards stay with
+  /// their owners. Moves made with makeMove can no longer be unmade afterwards.
+  ///
+  /// @param viewerId ID of the player whose view is kept (1 or 2)
+  /// @param seed     Seed of the shuffles
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void redealHiddenCards(int viewerId, uint64_t seed);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Returns the Zobrist hash of the current state: cards and where they are, creature stats, player
+  /// stats, round and turn. It is kept up to date incrementally by every change, so reading it is
+  /// O(1). Equal states reached through different move orders have equal hashes.
+  ///
+  /// @return 64-bit hash of the game state
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  uint64_t stateHash() const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Computes the same hash as stateHash() from scratch by walking the whole state. Much slower;
+  /// meant for checking that the incremental hash has not drifted.
+  ///
+  /// @return 64-bit hash of the game state
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  uint64_t computeStateHash() const;
+
 private:
   GameConfigParser cfg;
   MessageConfigParser msgs;
   CardFactory factory;
-  Deck deck1, deck2;
   Player p1, p2;
   Board board;
   int roundNumber;
@@ -426,12 +691,50 @@ private:
 
   GameResult result = GameResult::None;
   std::string gameConfigPath;
+  OutputSink *sink = &OutputSink::console();
+  std::ostream *output = &sink->stream(); // cached sink->stream()
+  UndoJournal journal; // changes of the moves made by makeMove; never copied
+  StateHash hash; // incremental hash of the cards, players and board (see stateHash())
+  FightBatch fightBatch; // scratch lanes of the silent battle phase; never copied
+
+  // Fights of the coming battle phase resolved up front (see queueFights()); never copied
+  FightOutcome battleOutcomes[7];
+  bool hasBattleOutcome[7] = {};
+  int battleLanes[7] = {};
+  bool fightsTaken = false;
+
+  void bindCardHolders();
+
+  void setupPlayers();
+
+  void copyState(const Game &other);
+
+  void saveScalars();
+
+  uint64_t scalarHash() const;
+
+  uint64_t cardHash() const;
 
   void printWelcome();
 
-  void promptPlayer();
+  void promptPlayer(CommandSource &source);
 
   bool gameOver = false;
 
   void writeResultToConfig();
+
+  bool endsWithEmptyDeck();
+
+  void applyFight(CreatureCard &attackerCreature, CreatureCard &defenderCreature, const FightOutcome &outcome);
+
+  // Actions executed by apply (GameActions.cpp)
+  CommandStatus applyDone();
+
+  CommandStatus playCreature(const Command &command);
+
+  CommandStatus moveToBattle(const Command &command);
+
+  CommandStatus redraw();
+
+  CommandStatus castSpell(const Command &command);
 };
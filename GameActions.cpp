@@ -0,0 +1,629 @@
+// --------------------------- GameActions.cpp ---------------------------
+//
+// Implements Game::apply and the player actions it executes: ending the
+// turn, playing creatures, moving them into battle, redrawing and casting
+// spells. Errors are returned as CommandStatus codes; printing the matching
+// E_* message is left to the caller.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include <algorithm>
+#include "Game.hpp"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Executes a command for the current player.
+///
+/// @param command Command to execute
+///
+/// @return CommandStatus::Ok if the action was performed, otherwise the reason it was rejected
+///         (the game state is left unchanged in that case)
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus Game::apply(const Command &command)
+{
+  switch (command.verb)
+  {
+    case Verb::Done: return applyDone();
+    case Verb::Creature: return playCreature(command);
+    case Verb::Battle: return moveToBattle(command);
+    case Verb::Redraw: return redraw();
+    case Verb::Spell: return castSpell(command);
+    default: return CommandStatus::UnknownCommand;
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Executes a command with an open undo frame. A rejected command changes nothing, so its frame is
+/// closed again right away.
+///
+/// @param command Command to execute
+///
+/// @return The status returned by apply
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus Game::makeMove(const Command &command)
+{
+  journal.begin(factory.getPool());
+  saveScalars();
+  CommandStatus status = apply(command);
+  if (status != CommandStatus::Ok)
+  {
+    journal.undo(factory.getPool());
+  }
+  return status;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Reverts the innermost move made by makeMove.
+//---------------------------------------------------------------------------------------------------------------------
+void Game::unmakeMove()
+{
+  journal.undo(factory.getPool());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Records the round and turn state of the game itself; the card holders record their own changes.
+//---------------------------------------------------------------------------------------------------------------------
+void Game::saveScalars()
+{
+  journal.save(doneCounter);
+  journal.save(roundNumber);
+  journal.save(currentPhase);
+  journal.save(boardPrinting);
+  journal.save(currentPlayerId);
+  journal.save(attacker);
+  journal.save(defender);
+  journal.save(result);
+  journal.save(gameOver);
+  journal.save(hash.raw());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Ends the turn of the current player. Applies Regenerate (odd rounds) and Poisoned to the
+/// player's field, and once both players are done runs the battle phase and starts the next round.
+///
+/// @return CommandStatus::Ok
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus Game::applyDone()
+{
+  doneCounter++;
+  Player &currentPlayer = getCurrentPlayer();
+  Zone &battleZone = (currentPlayer.getId() == 1)
+                       ? board.attackerField()
+                       : board.defenderField();
+  // Regenerate effect (odd rounds)
+  if (getCurrentRound() % 2 == 1)
+  {
+    for (int i = 0; i < 7; ++i)
+    {
+      Card *card = battleZone.getCard(i);
+      CreatureCard *creature = dynamic_cast<CreatureCard *>(card);
+      if (creature &&
+          creature->hasTrait(Trait::Regenerate) &&
+          creature->getHealth() < creature->getBaseHP())
+      {
+        creature->setHealth(creature->getBaseHP());
+        *output << msgs.getMessage(MessageKey::I_REGENERATE);
+      }
+    }
+  }
+  // Poisoned effect
+  for (int i = 0; i < 7; ++i)
+  {
+    Card *card = battleZone.getCard(i);
+    CreatureCard *creature = dynamic_cast<CreatureCard *>(card);
+    if (creature && creature->hasTrait(Trait::Poisoned))
+    {
+      creature->decreaseHealth(1);
+      *output << msgs.getMessage(MessageKey::I_POISONED);
+      if (creature->getHealth() <= 0)
+      {
+        currentPlayer.addToGraveyard(battleZone.extractCard(i));
+      }
+    }
+  }
+  if (doneCounter == 2)
+  {
+    // Only now both players have played "done"
+    initRound(); // prints boards
+    processBattlePhase();
+    if (isGameOver()) return CommandStatus::Ok;
+    incrementRound();
+    if (isGameOver()) return CommandStatus::Ok;
+    updateRolesForNewRound();
+    printRoundHeader();
+    initRound();
+    doneCounter = 0;
+  }
+  else
+  {
+    initRound();
+    switchPlayer();
+  }
+  return CommandStatus::Ok;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Places a creature from the current player's hand into one of their field slots.
+///
+/// @param command Creature command (card, source = field slot)
+///
+/// @return CommandStatus::Ok or the reason the creature cannot be played
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus Game::playCreature(const Command &command)
+{
+  Card *card = getCurrentPlayer().findCardInHand(command.card);
+  if (!card)
+  {
+    return CommandStatus::NotInHand;
+  }
+  if (card->getType() != CardType::Creature)
+  {
+    return CommandStatus::NotCreature;
+  }
+  if (command.source.zone != SlotZone::Field)
+  {
+    return CommandStatus::NotInField;
+  }
+  int index = command.source.index;
+  Zone &fieldZone = (getCurrentPlayer().getId() == 1) ? board.attackerField() : board.defenderField();
+  if (fieldZone.getHandle(index) != NO_CARD)
+  {
+    return CommandStatus::FieldOccupied;
+  }
+  int manaCost = card->getManaCost();
+  if (manaCost > getCurrentPlayer().getMana())
+  {
+    return CommandStatus::NotEnoughMana;
+  }
+  getCurrentPlayer().disableRedraw();
+  Player &player = getCurrentPlayer();
+  player.subtractMana(manaCost);
+  CardHandle creaturePtr = player.extractCardFromHand(card);
+  CreatureCard *creature = factory.getPool().getCreature(creaturePtr);
+  creature->resetStats();
+  creature->setSummonedRound(getCurrentRound());
+  fieldZone.addCard(index, creaturePtr);
+  *output << msgs.getCardInfo(creature->getID());
+  return CommandStatus::Ok;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Moves a creature of the current player from a field slot into a battle slot and applies
+/// Challenger and Haste.
+///
+/// @param command Battle command (source = field slot, target = battle slot)
+///
+/// @return CommandStatus::Ok or the reason the creature cannot move
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus Game::moveToBattle(const Command &command)
+{
+  int playerId = getCurrentPlayer().getId();
+  if (command.source.zone != SlotZone::Field)
+  {
+    return CommandStatus::NotInField;
+  }
+  int fieldIndex = command.source.index;
+  Zone &fieldZone = (playerId == 1)
+                      ? board.attackerField()
+                      : board.defenderField();
+  Card *fieldCard = fieldZone.getCard(fieldIndex);
+  if (fieldCard == nullptr)
+  {
+    return CommandStatus::FieldEmpty;
+  }
+  CreatureCard *creature = dynamic_cast<CreatureCard *>(fieldCard);
+  int currentRound = getCurrentRound();
+  if (creature->getSummonedRound() == currentRound && !creature->hasTrait(Trait::Haste))
+  {
+    return CommandStatus::CreatureCannotBattle;
+  }
+  if (command.target.zone != SlotZone::Battle)
+  {
+    return CommandStatus::NotInBattle;
+  }
+  int battleIndex = command.target.index;
+  Zone &battleZone = (playerId == 1)
+                       ? board.attackerBattle()
+                       : board.defenderBattle();
+  if (battleZone.getCard(battleIndex) != nullptr)
+  {
+    return CommandStatus::BattleOccupied;
+  }
+  getCurrentPlayer().disableRedraw();
+  CardHandle cardPtr = fieldZone.extractCard(fieldIndex);
+  CreatureCard *movedCreature = factory.getPool().getCreature(cardPtr);
+  if (movedCreature)
+  {
+    movedCreature->setLastFieldOwner(playerId);
+  }
+  battleZone.addCard(battleIndex, cardPtr);
+
+  // Challenger trait logic
+  if (movedCreature && movedCreature->hasTrait(Trait::Challenger))
+  {
+    Zone &opponentField = (playerId == 1)
+                            ? board.defenderField()
+                            : board.attackerField();
+
+    Zone &opponentBattle = (playerId == 1)
+                             ? board.defenderBattle()
+                             : board.attackerBattle();
+
+    Card *opponentFieldCard = opponentField.getCard(battleIndex);
+    Card *opponentBattleCard = opponentBattle.getCard(battleIndex);
+
+    if (opponentFieldCard != nullptr && opponentBattleCard == nullptr &&
+        opponentFieldCard->getType() == CardType::Creature)
+    {
+      CardHandle moved = opponentField.extractCard(battleIndex);
+      opponentBattle.addCard(battleIndex, moved);
+      *output << msgs.getMessage(MessageKey::I_CHALLENGER);
+    }
+  }
+  if (creature->getSummonedRound() == getCurrentRound() && creature->hasTrait(Trait::Haste))
+  {
+    *output << msgs.getMessage(MessageKey::I_HASTE);
+  }
+  return CommandStatus::Ok;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Discards the current player's hand and draws one card less.
+///
+/// @return CommandStatus::Ok or the reason no redraw is possible
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus Game::redraw()
+{
+  Player &player = getCurrentPlayer();
+  if (!player.canRedraw())
+  {
+    return (player.getHand().size() < 2) ? CommandStatus::RedrawNotEnoughCards : CommandStatus::RedrawDisabled;
+  }
+  player.performRedraw();
+  return CommandStatus::Ok;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Casts a spell from the current player's hand: general spells act on the board, target spells
+/// on one creature and graveyard spells on a creature in the player's graveyard.
+///
+/// @param command Spell command (card and its target slot or graveyard card)
+///
+/// @return CommandStatus::Ok or the reason the spell cannot be cast
+//---------------------------------------------------------------------------------------------------------------------
+CommandStatus Game::castSpell(const Command &command)
+{
+  Card *card = getCurrentPlayer().findCardInHand(command.card);
+  if (!card)
+  {
+    return CommandStatus::NotInHand;
+  }
+  if (card->getType() != CardType::Spell)
+  {
+    return CommandStatus::NotSpell;
+  }
+  SpellCard *spell = dynamic_cast<SpellCard *>(card);
+  SpellType type = spell->getSpellType();
+  SpellEffect effect = spell->getEffect();
+  if ((type == SpellType::General && command.targetCount != 0) ||
+      (type != SpellType::General && command.targetCount != 1))
+  {
+    return CommandStatus::InvalidParamCountSpell;
+  }
+  Player &player = getCurrentPlayer();
+  int manaCost = spell->getManaCost();
+  if (manaCost > player.getMana())
+  {
+    return CommandStatus::NotEnoughMana;
+  }
+
+  // General spells
+  if (type == SpellType::General)
+  {
+    *output << msgs.getCardInfo(spell->getID());
+    if (effect == SpellEffect::BattleCry)
+    {
+      vector<Zone *> ownZones = {
+        &board.attackerBattle(),
+        &board.attackerField()
+      };
+      if (player.getId() == 2)
+      {
+        ownZones = {
+          &board.defenderBattle(),
+          &board.defenderField()
+        };
+      }
+      for (Zone *zone: ownZones)
+      {
+        for (int i = 0; i < 7; ++i)
+        {
+          Card *c = zone->getCard(i);
+          if (c && c->getType() == CardType::Creature)
+          {
+            CreatureCard *creature = dynamic_cast<CreatureCard *>(c);
+            if (creature)
+            {
+              creature->addTrait(Trait::Haste);
+              creature->addTrait(Trait::Temporary);
+              creature->increaseAttack(3);
+            }
+          }
+        }
+      }
+    }
+    else if (effect == SpellEffect::Meteor)
+    {
+      vector<Zone *> zones = {
+        &board.attackerBattle(), &board.defenderBattle(),
+        &board.attackerField(), &board.defenderField()
+      };
+      for (Zone *zone: zones)
+      {
+        for (int i = 0; i < 7; ++i)
+        {
+          Card *c = zone->getCard(i);
+          if (c && c->getType() == CardType::Creature)
+          {
+            CreatureCard *creature = dynamic_cast<CreatureCard *>(c);
+            if (creature)
+            {
+              creature->takeDamage(3);
+              if (creature->getHealth() <= 0)
+              {
+                CardHandle dead = zone->extractCard(i);
+                int ownerId = (zone == &board.attackerBattle() || zone == &board.attackerField())
+                                ? 1
+                                : 2;
+                getPlayerById(ownerId).addToGraveyard(dead);
+              }
+            }
+          }
+        }
+      }
+    }
+    else if (effect == SpellEffect::Fireball)
+    {
+      Player &enemy = getOpponentPlayer();
+      int opponentId = enemy.getId();
+      vector<Zone *> zones = {
+        (opponentId == 1) ? &board.attackerBattle() : &board.defenderBattle(),
+        (opponentId == 1) ? &board.attackerField() : &board.defenderField()
+      };
+      for (Zone *zone: zones)
+      {
+        for (int i = 0; i < 7; ++i)
+        {
+          Card *c = zone->getCard(i);
+          if (c && c->getType() == CardType::Creature)
+          {
+            CreatureCard *creature = dynamic_cast<CreatureCard *>(c);
+            if (creature)
+            {
+              creature->takeDamage(2);
+              if (creature->getHealth() <= 0)
+              {
+                CardHandle dead = zone->extractCard(i);
+                int ownerId = (zone == &board.attackerBattle() || zone == &board.attackerField())
+                                ? 1
+                                : 2;
+                getPlayerById(ownerId).addToGraveyard(dead);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    player.removeCardFromHand(card);
+    player.subtractMana(manaCost);
+    player.disableRedraw();
+    return CommandStatus::Ok;
+  }
+  // Target spells
+  else if (type == SpellType::Target)
+  {
+    const Slot &slot = command.target;
+    if (slot.zone == SlotZone::None)
+    {
+      return CommandStatus::InvalidSlotSpell;
+    }
+    int ownerId = slot.opponent ? getOpponentPlayer().getId() : getCurrentPlayer().getId();
+    Zone *zone = (slot.zone == SlotZone::Field)
+                   ? ((ownerId == 1) ? &board.attackerField() : &board.defenderField())
+                   : ((ownerId == 1) ? &board.attackerBattle() : &board.defenderBattle());
+    int index = slot.index;
+    Card *target = zone->getCard(index);
+    if (!target || target->getType() != CardType::Creature)
+    {
+      return CommandStatus::TargetEmpty;
+    }
+    CreatureCard *creature = dynamic_cast<CreatureCard *>(target);
+
+    int manaCost = spell->getManaCost();
+    if (manaCost == -1)
+    {
+      if (effect == SpellEffect::Curse) manaCost = creature->getManaCost() + 1;
+      else if (effect == SpellEffect::Clone) manaCost = (creature->getManaCost() + 1) / 2;
+    }
+    if (manaCost > getCurrentPlayer().getMana())
+    {
+      return CommandStatus::NotEnoughMana;
+    }
+    if (effect == SpellEffect::Shock)
+    {
+      creature->takeDamage(1);
+      if (creature->getHealth() <= 0)
+      {
+        CardHandle removed = zone->extractCard(index);
+        if (slot.opponent) getOpponentPlayer().addToGraveyard(removed);
+        else getCurrentPlayer().addToGraveyard(removed);
+      }
+    }
+    else if (effect == SpellEffect::Mobilize)
+    {
+      creature->addTrait(Trait::Haste);
+      creature->increaseAttack(1);
+    }
+    else if (effect == SpellEffect::RapidRush)
+    {
+      creature->addTrait(Trait::FirstStrike);
+      creature->addTrait(Trait::Temporary);
+      creature->increaseAttack(2);
+    }
+    else if (effect == SpellEffect::Shield)
+    {
+      creature->increaseHealth(2);
+    }
+    else if (effect == SpellEffect::Amputate)
+    {
+      creature->removeFirstTraitAlphabetically();
+    }
+    else if (effect == SpellEffect::FinalAct)
+    {
+      creature->addTrait(Trait::Brutal);
+      creature->addTrait(Trait::Haste);
+      creature->addTrait(Trait::Temporary);
+      creature->increaseAttack(3);
+    }
+    else if (effect == SpellEffect::Loyalty)
+    {
+      creature->addTrait(Trait::Haste);
+      creature->increaseHealth(1);
+    }
+    else if (effect == SpellEffect::Zombify)
+    {
+      creature->addTrait(Trait::Venomous);
+      creature->addTrait(Trait::Undying);
+    }
+    else if (effect == SpellEffect::Bloodlust)
+    {
+      creature->addTrait(Trait::Brutal);
+      creature->addTrait(Trait::Lifesteal);
+      int newHP = (creature->getHealth() + 1) / 2;
+      creature->decreaseHealth(creature->getHealth() - newHP);
+    }
+    else if (effect == SpellEffect::Curse)
+    {
+      creature->addTrait(Trait::Temporary);
+    }
+    else if (effect == SpellEffect::Clone)
+    {
+      Zone &fieldZone = (player.getId() == 1)
+                          ? board.attackerField()
+                          : board.defenderField();
+      int emptyIndex = -1;
+      for (int i = 0; i < 7; ++i)
+      {
+        if (fieldZone.getCard(i) == nullptr)
+        {
+          emptyIndex = i;
+          break;
+        }
+      }
+      if (emptyIndex != -1)
+      {
+        CardHandle clonedCard = factory.createCard(creature->getKind());
+        CreatureCard *clone = factory.getPool().getCreature(clonedCard);
+        clone->resetStats();
+        clone->setSummonedRound(getCurrentRound());
+        clone->increaseAttack(creature->getAttack() - clone->getAttack());
+        clone->increaseHealth(creature->getHealth() - clone->getHealth());
+        for (Trait t: creature->getBaseTraits())
+        {
+          clone->addTrait(t);
+        }
+        clone->addTrait(Trait::Haste);
+        clone->addTrait(Trait::Temporary);
+        fieldZone.addCard(emptyIndex, clonedCard);
+      }
+    }
+    player.removeCardFromHand(card);
+    player.subtractMana(manaCost);
+    player.disableRedraw();
+    *output << msgs.getCardInfo(spell->getID());
+    return CommandStatus::Ok;
+  }
+  // Graveyard spells
+  else if (type == SpellType::Graveyard)
+  {
+    CardKind graveKind = command.graveyardTarget;
+    CardPool &cards = factory.getPool();
+    const auto &grave = player.getGraveyard();
+    auto it = std::find_if(grave.rbegin(), grave.rend(),
+                           [&](CardHandle c) { return cards.get(c)->getKind() == graveKind; });
+    if (it == grave.rend())
+    {
+      return CommandStatus::NotInGraveyard;
+    }
+    CardHandle graveHandle = *it;
+    CreatureCard *graveCreature = cards.getCreature(graveHandle);
+    if (effect == SpellEffect::HeroicMemory)
+    {
+      int manaCost = (graveCreature->getManaCost() + 1) / 2;
+      if (manaCost > player.getMana())
+      {
+        return CommandStatus::NotEnoughMana;
+      }
+      Zone &playerField = (player.getId() == 1)
+                            ? board.attackerField()
+                            : board.defenderField();
+      int emptyIndex = -1;
+      for (int i = 0; i < 7; ++i)
+      {
+        if (!playerField.getCard(i))
+        {
+          emptyIndex = i;
+          break;
+        }
+      }
+      if (emptyIndex != -1)
+      {
+        CardHandle revived = factory.createCard(graveCreature->getKind());
+        CreatureCard *revivedCreature = cards.getCreature(revived);
+        revivedCreature->resetStats();
+        revivedCreature->addTrait(Trait::Haste);
+        revivedCreature->addTrait(Trait::Temporary);
+        playerField.addCard(emptyIndex, revived);
+      }
+      player.removeCardFromHand(card);
+      player.subtractMana(manaCost);
+      player.disableRedraw();
+      *output << msgs.getMessage(MessageKey::I_MEMRY);
+    }
+    else if (effect == SpellEffect::Revive)
+    {
+      int manaCost = 2;
+      if (manaCost > player.getMana())
+      {
+        return CommandStatus::NotEnoughMana;
+      }
+
+      player.removeLastFromGraveyard(graveHandle);
+
+      CardHandle revived = factory.createCard(graveCreature->getKind());
+      CreatureCard *revivedCreature = cards.getCreature(revived);
+      revivedCreature->resetStats();
+      player.addCardToHand(revived);
+
+      player.removeCardFromHand(card);
+      player.subtractMana(manaCost);
+      player.disableRedraw();
+      *output << msgs.getMessage(MessageKey::I_REVIV);
+    }
+    return CommandStatus::Ok;
+  }
+  return CommandStatus::Ok;
+}
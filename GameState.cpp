@@ -0,0 +1,205 @@
+// --------------------------- GameState.cpp ---------------------------
+//
+// Implements Game::saveState and Game::loadState, the conversion between
+// a Game and its flat GameState snapshot, and the state hash queries.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "Game.hpp"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Captures the game. Card handles are kept as they are, so a snapshot refers to the same card
+/// instances as the game it was taken from.
+///
+/// @param state Receives the snapshot
+///
+/// @return false if the game does not fit a GameState
+//---------------------------------------------------------------------------------------------------------------------
+bool Game::saveState(GameState &state) const
+{
+  const CardPool &pool = factory.getPool();
+  if (pool.size() > MAX_STATE_CARDS) return false;
+
+  state.roundNumber = roundNumber;
+  state.currentPlayerId = static_cast<uint8_t>(currentPlayerId);
+  state.attackerId = static_cast<uint8_t>(attacker ? attacker->getId() : 0);
+  state.doneCounter = static_cast<uint8_t>(doneCounter);
+  state.phase = static_cast<uint8_t>(currentPhase);
+  state.result = static_cast<uint8_t>(result);
+  state.gameOver = gameOver;
+  state.boardPrinting = boardPrinting;
+  state.cardCount = static_cast<uint8_t>(pool.size());
+
+  if (!p1.saveState(state.players[0]) || !p2.saveState(state.players[1])) return false;
+
+  const Zone *zones[4] = {&board.attackerField(), &board.attackerBattle(),
+                          &board.defenderField(), &board.defenderBattle()};
+  for (int z = 0; z < 4; ++z)
+  {
+    for (int i = 0; i < 7; ++i)
+    {
+      CardHandle handle = zones[z]->getHandle(i);
+      state.board[z][i] = (handle == NO_CARD) ? NO_STATE_CARD : static_cast<StateHandle>(handle);
+    }
+  }
+
+  for (CardHandle handle = 0; handle < pool.size(); ++handle)
+  {
+    CardState &card = state.cards[handle];
+    card = CardState();
+    card.kind = pool.get(handle)->getKind();
+    const CreatureCard *creature = pool.getCreature(handle);
+    if (creature && !creature->saveState(card)) return false;
+  }
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Restores a snapshot. Card instances the snapshot does not know are destroyed and missing ones
+/// are created, so the pool matches the snapshot handle by handle; the storage of all lists is
+/// reused.
+///
+/// @param state Snapshot written by saveState
+//---------------------------------------------------------------------------------------------------------------------
+void Game::loadState(const GameState &state)
+{
+  journal.clear();
+  CardPool &pool = factory.getPool();
+
+  // Keep the instances that have the same kind as in the snapshot
+  size_t matching = 0;
+  while (matching < pool.size() && matching < state.cardCount &&
+         pool.get(static_cast<CardHandle>(matching))->getKind() == state.cards[matching].kind)
+  {
+    ++matching;
+  }
+  pool.truncate(matching);
+  for (size_t handle = matching; handle < state.cardCount; ++handle)
+  {
+    factory.createCard(state.cards[handle].kind);
+  }
+  for (CardHandle handle = 0; handle < state.cardCount; ++handle)
+  {
+    if (CreatureCard *creature = pool.getCreature(handle)) creature->loadState(state.cards[handle]);
+  }
+
+  p1.loadState(state.players[0]);
+  p2.loadState(state.players[1]);
+
+  Zone *zones[4] = {&board.attackerField(), &board.attackerBattle(),
+                    &board.defenderField(), &board.defenderBattle()};
+  for (int z = 0; z < 4; ++z)
+  {
+    for (int i = 0; i < 7; ++i)
+    {
+      StateHandle handle = state.board[z][i];
+      zones[z]->addCard(i, (handle == NO_STATE_CARD) ? NO_CARD : handle);
+    }
+  }
+
+  roundNumber = state.roundNumber;
+  currentPlayerId = state.currentPlayerId;
+  attacker = (state.attackerId == 1) ? &p1 : (state.attackerId == 2) ? &p2 : nullptr;
+  defender = (state.attackerId == 1) ? &p2 : (state.attackerId == 2) ? &p1 : nullptr;
+  doneCounter = state.doneCounter;
+  currentPhase = static_cast<Phase>(state.phase);
+  result = static_cast<GameResult>(state.result);
+  gameOver = state.gameOver;
+  boardPrinting = state.boardPrinting;
+
+  // Creating and overwriting cards above left the incremental hash meaningless
+  hash.reset(cardHash());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Shuffles the hidden cards of both players and rebuilds the hash.
+///
+/// @param viewerId ID of the player whose view is kept
+/// @param seed     Seed of the shuffles
+//---------------------------------------------------------------------------------------------------------------------
+void Game::redealHiddenCards(int viewerId, uint64_t seed)
+{
+  journal.clear();
+  p1.redealHidden(viewerId != 1, seed);
+  p2.redealHidden(viewerId != 2, seed ^ 0xA0761D6478BD642Full);
+  hash.reset(cardHash());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Hash of the round and turn scalars. They change far less often than they are written, so they
+/// are folded in when the hash is read instead of being tracked.
+///
+/// @return XOR of the round and turn keys
+//---------------------------------------------------------------------------------------------------------------------
+uint64_t Game::scalarHash() const
+{
+  uint64_t turn = static_cast<uint64_t>(currentPlayerId) |
+                  (static_cast<uint64_t>(attacker ? attacker->getId() : 0) << 8) |
+                  (static_cast<uint64_t>(doneCounter & 0xFF) << 16) |
+                  (static_cast<uint64_t>(currentPhase) << 24) |
+                  (static_cast<uint64_t>(result) << 32) |
+                  (static_cast<uint64_t>(gameOver) << 36);
+  return StateHash::key(HashFeature::Round, 0, static_cast<uint32_t>(roundNumber)) ^
+         StateHash::key(HashFeature::Turn, 0, turn);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// @return Incrementally maintained hash of the game state
+//---------------------------------------------------------------------------------------------------------------------
+uint64_t Game::stateHash() const
+{
+  return hash.value() ^ scalarHash();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// @return Hash of the game state, computed from scratch
+//---------------------------------------------------------------------------------------------------------------------
+uint64_t Game::computeStateHash() const
+{
+  return cardHash() ^ scalarHash();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Computes the part of the hash that is maintained incrementally (everything but the round and
+/// turn scalars) from scratch.
+///
+/// @return Hash of the players, board and creatures
+//---------------------------------------------------------------------------------------------------------------------
+uint64_t Game::cardHash() const
+{
+  StateHash full;
+  p1.hashState(full);
+  p2.hashState(full);
+
+  const Zone *zones[4] = {&board.attackerField(), &board.attackerBattle(),
+                          &board.defenderField(), &board.defenderBattle()};
+  for (int z = 0; z < 4; ++z)
+  {
+    for (int i = 0; i < 7; ++i)
+    {
+      CardHandle handle = zones[z]->getHandle(i);
+      if (handle != NO_CARD) full.toggle(HashFeature::CardInZone, handle, static_cast<uint64_t>(z * 7 + i));
+    }
+  }
+
+  // A size_t counter cannot wrap; the pool refuses to grow past the handle space (MAX_CARDS)
+  const CardPool &pool = factory.getPool();
+  for (size_t index = 0; index < pool.size(); ++index)
+  {
+    const CardHandle handle = static_cast<CardHandle>(index);
+    full.toggle(HashFeature::Kind, handle, static_cast<uint64_t>(pool.get(handle)->getKind()));
+    if (const CreatureCard *creature = pool.getCreature(handle)) creature->hashStats(full);
+  }
+  return full.value();
+}
@@ -0,0 +1,91 @@
+// --------------------------- GameState.hpp ---------------------------
+//
+// Declares GameState, a flat, trivially copyable snapshot of everything a
+// Game changes while it is played. Game::saveState and Game::loadState
+// convert between a game and a snapshot.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "CardDefinition.hpp"
+#include "Trait.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Card handle inside a GameState. Games with more card instances than fit do not have a snapshot:
+/// Game::saveState fails once a game has created more than MAX_STATE_CARDS cards (both decks plus
+/// every card that CLONE, MEMRY or REVIV added), so larger games must use the live object graph.
+///
+//---------------------------------------------------------------------------------------------------------------------
+using StateHandle = uint8_t;
+
+constexpr size_t MAX_STATE_CARDS = 96; // card instances a GameState can hold
+constexpr StateHandle NO_STATE_CARD = UINT8_MAX;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Mutable part of one card instance. Only creatures use the stats.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct CardState
+{
+  int32_t summonedRound; ///< any round a game can reach
+  CardKind kind; ///< definition of the card, so instances can be recreated
+  int16_t attack;
+  int16_t health;
+  TraitSet traits;
+  int8_t lastFieldIndex;
+  int8_t lastFieldOwner;
+  bool resurrected;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Everything that changes for one player. Deck (top card first), hand and graveyard share one
+/// array in that order.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct PlayerState
+{
+  int32_t health;
+  int32_t mana;
+  int32_t manaPoolSize;
+  bool redrawEnabled;
+  uint32_t deckSequence; ///< sequence number of the top deck card (see Deck)
+  uint8_t deckCount;
+  uint8_t handCount;
+  uint8_t graveyardCount;
+  std::array<StateHandle, MAX_STATE_CARDS> cards;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Complete mutable state of a Game in fixed-size arrays, without pointers. Copying it is a single
+/// memcpy, so it can be cloned for rollouts or handed to another thread. The configuration,
+/// messages and card definitions are not part of it; a state can only be loaded into a game built
+/// from the same configs.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct GameState
+{
+  int32_t roundNumber;
+  uint8_t currentPlayerId; ///< 1 or 2
+  uint8_t attackerId; ///< 1 or 2
+  uint8_t doneCounter;
+  uint8_t phase; ///< Phase of the game
+  uint8_t result; ///< GameResult
+  bool gameOver;
+  bool boardPrinting;
+  uint8_t cardCount; ///< number of card instances
+  std::array<PlayerState, 2> players; ///< player 1, player 2
+  std::array<std::array<StateHandle, 7>, 4> board; ///< attacker field, attacker battle, defender field, defender battle
+  std::array<CardState, MAX_STATE_CARDS> cards; ///< indexed by card handle
+};
+
+static_assert(std::is_trivially_copyable_v<GameState>, "GameState must be copyable with memcpy");
@@ -0,0 +1,444 @@
+// --------------------------- GreedyBot.cpp ---------------------------
+//
+// Implements the one-ply heuristic of the GreedyBot.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "GreedyBot.hpp"
+#include "Game.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+  constexpr int FACE_WEIGHT = 2; // value of one point of player health
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// The stats of a creature the heuristic looks at.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct Fighter
+  {
+    int attack = 0;
+    int health = 0;
+    TraitSet traits;
+  };
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Field and battle zone of one player.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct Side
+  {
+    const Zone *field;
+    const Zone *battle;
+  };
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// @param game     Game
+/// @param playerId Player 1 or 2
+///
+/// @return The zones of the player
+//---------------------------------------------------------------------------------------------------------------------
+static Side sideOf(const Game &game, int playerId)
+{
+  const Board &board = game.getBoard();
+  if (playerId == 1) return {&board.attackerField(), &board.attackerBattle()};
+  return {&board.defenderField(), &board.defenderBattle()};
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// @param game Game
+/// @param zone Zone to look in
+/// @param slot 0-based slot
+///
+/// @return The creature in the slot, or nullptr
+//---------------------------------------------------------------------------------------------------------------------
+static const CreatureCard *creatureAt(const Game &game, const Zone &zone, int slot)
+{
+  CardHandle handle = zone.getHandle(slot);
+  return (handle == NO_CARD) ? nullptr : game.getCardFactory().getPool().getCreature(handle);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// @param creature A creature
+///
+/// @return Its current stats
+//---------------------------------------------------------------------------------------------------------------------
+static Fighter fighterOf(const CreatureCard &creature)
+{
+  return {creature.getAttack(), creature.getHealth(), creature.getTraits()};
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Worth of a creature with the given stats. Temporary creatures leave after this round's battle,
+/// so they are worth a quarter; dead ones nothing.
+///
+/// @param fighter Stats of the creature
+///
+/// @return Heuristic value
+//---------------------------------------------------------------------------------------------------------------------
+static int creatureValue(const Fighter &fighter)
+{
+  if (fighter.health <= 0) return 0;
+  const TraitSet traits = fighter.traits;
+  int value = 2 * fighter.attack + fighter.health;
+  if (traits.has(Trait::FirstStrike)) value += 2;
+  if (traits.has(Trait::Brutal)) value += 1;
+  if (traits.has(Trait::Challenger)) value += 1;
+  if (traits.has(Trait::Lifesteal)) value += 2;
+  if (traits.has(Trait::Regenerate)) value += 2;
+  if (traits.has(Trait::Undying)) value += 3;
+  if (traits.has(Trait::Venomous)) value += 1;
+  if (traits.has(Trait::Poisoned)) value -= 2;
+  if (traits.has(Trait::Temporary)) value /= 4;
+  return max(value, 1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Value of a fight between two battle slots for the owner of the first creature: creatures
+/// destroyed and player health gained and lost. Follows the order of Game::processBattlePhase:
+/// exactly one First Strike creature hits first and wins outright if it kills; otherwise the
+/// attacker hits first and the defender always hits back. Brutal overkill hits the owner of the
+/// killed creature, Lifesteal heals by the damage dealt.
+///
+/// @param own            Own creature
+/// @param enemy          Enemy creature
+/// @param ownIsAttacker  true if the own creature belongs to this round's attacker
+///
+/// @return Score of the fight
+//---------------------------------------------------------------------------------------------------------------------
+static int fightValue(Fighter own, Fighter enemy, bool ownIsAttacker)
+{
+  const int ownBefore = creatureValue(own);
+  const int enemyBefore = creatureValue(enemy);
+  int ownFace = 0; // health change of the own player
+  int enemyFace = 0; // health change of the enemy player
+
+  auto strike = [](const Fighter &hitter, Fighter &target, int &hitterFace, int &targetFace)
+  {
+    int before = target.health;
+    target.health -= hitter.attack;
+    if (hitter.traits.has(Trait::Brutal) && target.health <= 0) targetFace -= max(0, hitter.attack - before);
+    if (hitter.traits.has(Trait::Lifesteal)) hitterFace += hitter.attack;
+  };
+
+  bool ownFirst = own.traits.has(Trait::FirstStrike);
+  bool enemyFirst = enemy.traits.has(Trait::FirstStrike);
+  if (ownFirst != enemyFirst)
+  {
+    Fighter &first = ownFirst ? own : enemy;
+    Fighter &second = ownFirst ? enemy : own;
+    int &firstFace = ownFirst ? ownFace : enemyFace;
+    int &secondFace = ownFirst ? enemyFace : ownFace;
+    strike(first, second, firstFace, secondFace);
+    if (second.health > 0) strike(second, first, secondFace, firstFace);
+  }
+  else if (ownIsAttacker)
+  {
+    strike(own, enemy, ownFace, enemyFace);
+    strike(enemy, own, enemyFace, ownFace);
+  }
+  else
+  {
+    strike(enemy, own, enemyFace, ownFace);
+    strike(own, enemy, ownFace, enemyFace);
+  }
+
+  // Regenerate and Undying bring a killed creature back after the battle
+  int ownLost = ownBefore - creatureValue(own);
+  if (own.health <= 0 && (own.traits.has(Trait::Regenerate) || own.traits.has(Trait::Undying))) ownLost /= 3;
+  int enemyLost = enemyBefore - creatureValue(enemy);
+  if (enemy.health <= 0 && (enemy.traits.has(Trait::Regenerate) || enemy.traits.has(Trait::Undying))) enemyLost /= 3;
+  return enemyLost - ownLost + FACE_WEIGHT * (ownFace - enemyFace);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Scores placing a creature from hand into a field slot: its value, the mana it uses and, for the
+/// attacker, blocking the direct hit of an enemy battle creature in that slot.
+///
+/// @param game Game
+/// @param move Creature command
+///
+/// @return Score
+//---------------------------------------------------------------------------------------------------------------------
+static int scoreCreature(const Game &game, const Command &move)
+{
+  const CardDefinition &card = game.getCardFactory().getCatalog().get(move.card);
+  int score = creatureValue({card.baseATK, card.baseHP, card.baseTraits}) + card.manaCost;
+
+  const int me = game.getCurrentPlayer().getId();
+  if (game.getAttacker().getId() == me)
+  {
+    const int slot = move.source.index;
+    const CreatureCard *threat = creatureAt(game, *sideOf(game, 3 - me).battle, slot);
+    if (threat && !creatureAt(game, *sideOf(game, me).battle, slot) && !creatureAt(game, *sideOf(game, me).field, slot))
+    {
+      score += FACE_WEIGHT * threat->getAttack();
+    }
+  }
+  return score;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Scores moving a creature into a battle slot by the fight it leads to. Without an opponent in the
+/// slot a Challenger pulls the enemy field creature of the slot in; otherwise the creature hits
+/// the enemy player directly (attacker), or the attacker if their slot is open (defender). A
+/// defender blocking an enemy battle creature also saves the direct hit.
+///
+/// @param game Game
+/// @param move Battle command
+///
+/// @return Score
+//---------------------------------------------------------------------------------------------------------------------
+static int scoreBattle(const Game &game, const Command &move)
+{
+  const int me = game.getCurrentPlayer().getId();
+  const bool attacking = (game.getAttacker().getId() == me);
+  const Side own = sideOf(game, me);
+  const Side enemy = sideOf(game, 3 - me);
+  const int slot = move.target.index;
+
+  const CreatureCard *creature = creatureAt(game, *own.field, move.source.index);
+  if (!creature) return 0;
+  const Fighter fighter = fighterOf(*creature);
+
+  const CreatureCard *opponent = creatureAt(game, *enemy.battle, slot);
+  if (opponent)
+  {
+    int saved = attacking ? 0 : FACE_WEIGHT * opponent->getAttack();
+    return fightValue(fighter, fighterOf(*opponent), attacking) + saved;
+  }
+  if (fighter.traits.has(Trait::Challenger))
+  {
+    const CreatureCard *challenged = creatureAt(game, *enemy.field, slot);
+    if (challenged) return fightValue(fighter, fighterOf(*challenged), attacking);
+  }
+  if (attacking) return FACE_WEIGHT * fighter.attack;
+  return creatureAt(game, *enemy.field, slot) ? 0 : FACE_WEIGHT * fighter.attack / 2;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Applies the stat changes of a target spell to a copy of the target's stats.
+///
+/// @param effect Spell effect
+/// @param target Stats to change
+//---------------------------------------------------------------------------------------------------------------------
+static void applyTargetSpell(SpellEffect effect, Fighter &target)
+{
+  switch (effect)
+  {
+    case SpellEffect::Shock: target.health -= 1; break;
+    case SpellEffect::Mobilize: target.attack += 1; target.traits.add(Trait::Haste); break;
+    case SpellEffect::RapidRush:
+      target.attack += 2;
+      target.traits.add(Trait::FirstStrike);
+      target.traits.add(Trait::Temporary);
+      break;
+    case SpellEffect::Shield: target.health += 2; break;
+    case SpellEffect::Amputate: target.traits.removeFirst(); break;
+    case SpellEffect::FinalAct:
+      target.attack += 3;
+      target.traits.add(Trait::Brutal);
+      target.traits.add(Trait::Haste);
+      target.traits.add(Trait::Temporary);
+      break;
+    case SpellEffect::Loyalty: target.health += 1; target.traits.add(Trait::Haste); break;
+    case SpellEffect::Zombify: target.traits.add(Trait::Venomous); target.traits.add(Trait::Undying); break;
+    case SpellEffect::Bloodlust:
+      target.health = (target.health + 1) / 2;
+      target.traits.add(Trait::Brutal);
+      target.traits.add(Trait::Lifesteal);
+      break;
+    case SpellEffect::Curse: target.traits.add(Trait::Temporary); break;
+    default: break;
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Value change of all creatures of one side when each takes the same damage.
+///
+/// @param game   Game
+/// @param side   Zones of the player
+/// @param damage Damage per creature
+///
+/// @return Value lost by that side
+//---------------------------------------------------------------------------------------------------------------------
+static int areaDamageLoss(const Game &game, const Side &side, int damage)
+{
+  int lost = 0;
+  for (const Zone *zone: {side.field, side.battle})
+  {
+    for (int i = 0; i < 7; ++i)
+    {
+      const CreatureCard *creature = creatureAt(game, *zone, i);
+      if (!creature) continue;
+      Fighter fighter = fighterOf(*creature);
+      int before = creatureValue(fighter);
+      fighter.health -= damage;
+      lost += before - creatureValue(fighter);
+    }
+  }
+  return lost;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Scores a spell: value added to own creatures minus value added to enemy ones. Attack gained by
+/// own creatures already in battle counts once more, since it hits this round.
+///
+/// @param game Game
+/// @param move Spell command
+///
+/// @return Score
+//---------------------------------------------------------------------------------------------------------------------
+static int scoreSpell(const Game &game, const Command &move)
+{
+  const CardDefinition &spell = game.getCardFactory().getCatalog().get(move.card);
+  const int me = game.getCurrentPlayer().getId();
+  const Side own = sideOf(game, me);
+  const Side enemy = sideOf(game, 3 - me);
+
+  if (spell.spellType == SpellType::General)
+  {
+    if (spell.effect == SpellEffect::Meteor) return areaDamageLoss(game, enemy, 3) - areaDamageLoss(game, own, 3);
+    if (spell.effect == SpellEffect::Fireball) return areaDamageLoss(game, enemy, 2);
+    if (spell.effect != SpellEffect::BattleCry) return 0;
+
+    int gain = 0;
+    for (const Zone *zone: {own.field, own.battle})
+    {
+      for (int i = 0; i < 7; ++i)
+      {
+        const CreatureCard *creature = creatureAt(game, *zone, i);
+        if (!creature) continue;
+        Fighter fighter = fighterOf(*creature);
+        int before = creatureValue(fighter);
+        fighter.attack += 3;
+        fighter.traits.add(Trait::Temporary);
+        gain += creatureValue(fighter) - before + ((zone == own.battle) ? 3 * FACE_WEIGHT : 0);
+      }
+    }
+    return gain;
+  }
+
+  if (spell.spellType == SpellType::Graveyard)
+  {
+    const CardDefinition &dead = game.getCardFactory().getCatalog().get(move.graveyardTarget);
+    Fighter revived{dead.baseATK, dead.baseHP, dead.baseTraits};
+    if (spell.effect == SpellEffect::Revive) return creatureValue(revived) / 2;
+    revived.traits.add(Trait::Haste);
+    revived.traits.add(Trait::Temporary);
+    return creatureValue(revived);
+  }
+
+  // Target spells
+  const int owner = move.target.opponent ? 3 - me : me;
+  const Side side = sideOf(game, owner);
+  const bool inBattle = (move.target.zone == SlotZone::Battle);
+  const CreatureCard *target = creatureAt(game, inBattle ? *side.battle : *side.field, move.target.index);
+  if (!target) return 0;
+  const Fighter before = fighterOf(*target);
+
+  if (spell.effect == SpellEffect::Clone)
+  {
+    bool room = false;
+    for (int i = 0; i < 7; ++i) room = room || !creatureAt(game, *own.field, i);
+    Fighter clone{before.attack, before.health, target->getBaseTraits()};
+    clone.traits.add(Trait::Haste);
+    clone.traits.add(Trait::Temporary);
+    return room ? creatureValue(clone) : 0;
+  }
+
+  Fighter after = before;
+  applyTargetSpell(spell.effect, after);
+  int gain = creatureValue(after) - creatureValue(before);
+  if (inBattle) gain += FACE_WEIGHT * (after.attack - before.attack);
+  return (owner == me) ? gain : -gain;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Dispatches on the kind of action.
+///
+/// @param game Game
+/// @param move Legal action
+///
+/// @return Score (0 for done, negative for redraw)
+//---------------------------------------------------------------------------------------------------------------------
+int GreedyBot::scoreMove(const Game &game, const Command &move)
+{
+  switch (move.verb)
+  {
+    case Verb::Creature: return scoreCreature(game, move);
+    case Verb::Battle: return scoreBattle(game, move);
+    case Verb::Spell: return scoreSpell(game, move);
+    case Verb::Redraw: return -1; // throws away a card; never worth it one ply ahead
+    default: return 0;
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the best scoring action; "done" unless something scores above zero.
+///
+/// @param game  Game
+/// @param moves Legal actions
+///
+/// @return Index of the chosen action
+//---------------------------------------------------------------------------------------------------------------------
+size_t GreedyBot::choose(const Game &game, const MoveList &moves)
+{
+  size_t best = 0;
+  int bestScore = 0;
+  bool found = false;
+  for (size_t i = 0; i < moves.size(); ++i)
+  {
+    if (moves[i].verb == Verb::Done)
+    {
+      if (!found) best = i;
+      continue;
+    }
+    int score = scoreMove(game, moves[i]);
+    if (score > bestScore)
+    {
+      best = i;
+      bestScore = score;
+      found = true;
+    }
+  }
+  return best;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Generates the actions, picks one and formats it.
+///
+/// @param game    Game asking for a command
+/// @param command Receives the command line
+///
+/// @return false if there is no legal action
+//---------------------------------------------------------------------------------------------------------------------
+bool GreedyBot::nextCommand(const Game &game, string &command)
+{
+  MoveList moves;
+  generateMoves(game, moves);
+  if (moves.empty()) return false;
+  command = formatCommand(moves[choose(game, moves)], game.getCardFactory().getCatalog());
+  return true;
+}
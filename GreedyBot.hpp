@@ -0,0 +1,73 @@
+// --------------------------- GreedyBot.hpp ---------------------------
+//
+// Declares the GreedyBot, a cheap one-ply heuristic player used as the
+// default opponent of mass simulations and as a rollout policy.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "CommandSource.hpp"
+#include "MoveGenerator.hpp"
+
+class Game;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Computer player that scores every legal action of the current player once and plays the best
+/// one, or "done" if nothing scores above zero. Scores are read straight from the state through
+/// the Player, Zone and CreatureCard accessors, without making the action:
+///
+/// - creatures are worth their attack, health and traits (Temporary ones only for this round),
+///   and playing one also scores its mana cost, so the mana of a turn gets spent;
+/// - a battle move scores the creatures and player health won and lost in the fight it leads to,
+///   with First Strike order, Brutal overkill and Lifesteal, a Challenger pulling an enemy out of
+///   the field, or the direct hit it deals or blocks;
+/// - a spell scores the value it adds to own creatures minus the value it adds to enemy ones.
+///
+/// Choosing an action does not allocate, so the bot is cheap enough to drive rollouts.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class GreedyBot : public CommandSource
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Scores an action of the current player. "done" scores 0.
+  ///
+  /// @param game State the action would be played in
+  /// @param move A legal action (see generateMoves)
+  ///
+  /// @return Heuristic gain of the action
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static int scoreMove(const Game &game, const Command &move);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Picks the best action of a move list. Ties go to the action generated first.
+  ///
+  /// @param game  State the moves were generated for
+  /// @param moves Legal actions of the current player (not empty)
+  ///
+  /// @return Index of the chosen action in moves
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static size_t choose(const Game &game, const MoveList &moves);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Writes the chosen action as a command line.
+  ///
+  /// @param game    Game asking for a command
+  /// @param command Receives the command line
+  ///
+  /// @return false if the game has no legal action
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool nextCommand(const Game &game, std::string &command) override;
+};
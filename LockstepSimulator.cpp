@@ -0,0 +1,83 @@
+// --------------------------- LockstepSimulator.cpp ---------------------------
+//
+// Implements the LockstepSimulator: stepping a group of games to their
+// battle phases and resolving the fights of all of them together.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// -----------------------------------------------------------------------------
+#include "LockstepSimulator.hpp"
+#include "CommandSource.hpp"
+#include "Game.hpp"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Adds a game to the group played by the next play().
+///
+/// @param game   Game that has not started yet
+/// @param source Command source of the game
+///
+//---------------------------------------------------------------------------------------------------------------------
+void LockstepSimulator::add(Game &game, CommandSource &source)
+{
+  lanes.push_back({&game, &source, string(), false});
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Plays the commands of a game up to the "done" that starts its battle phase, which is kept in
+/// the lane instead of being played.
+///
+/// @param lane Game to advance
+///
+/// @return false if the game ended or its source ran dry before the next battle phase
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool LockstepSimulator::advance(Lane &lane)
+{
+  while (lane.source->nextCommand(*lane.game, lane.command))
+  {
+    if (lane.game->startsBattle(lane.command)) return true;
+    if (!lane.game->playCommand(lane.command)) return false;
+  }
+  return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Advances every running game to its battle phase, resolves the fights of all of them in one
+/// batch and plays the waiting "done" commands, until no game is left running.
+///
+//---------------------------------------------------------------------------------------------------------------------
+void LockstepSimulator::play()
+{
+  for (Lane &lane: lanes)
+  {
+    lane.running = lane.game->startHeadless(discard);
+  }
+
+  bool anyRunning = true;
+  while (anyRunning)
+  {
+    batch.clear();
+    for (Lane &lane: lanes)
+    {
+      if (lane.running) lane.running = advance(lane);
+      if (lane.running) lane.game->queueFights(batch);
+    }
+    batch.resolve();
+
+    anyRunning = false;
+    for (Lane &lane: lanes)
+    {
+      if (!lane.running) continue;
+      lane.game->takeFights(batch);
+      lane.running = lane.game->playCommand(lane.command);
+      anyRunning = anyRunning || lane.running;
+    }
+  }
+  lanes.clear();
+}
@@ -0,0 +1,69 @@
+// --------------------------- LockstepSimulator.hpp ---------------------------
+//
+// Declares the LockstepSimulator, which plays a group of headless games
+// side by side and resolves their battle phases in one shared FightBatch.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "FightBatch.hpp"
+#include "OutputSink.hpp"
+
+class CommandSource;
+class Game;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Plays independent games in lockstep, one round at a time. Each game takes commands from its own
+/// source until the "done" that starts its battle phase; once every running game has reached that
+/// point, the fights of all of them go into one FightBatch, so a group of 16 games fills the
+/// vector lanes that the at most 7 fights of a single battle phase cannot. The games play exactly
+/// as with Game::simulate().
+///
+/// One simulator is meant for one thread; its batch and discard sink are reused by every group.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class LockstepSimulator
+{
+public:
+  static constexpr size_t DEFAULT_GAMES = 16; ///< games per group, two AVX-512 registers of fights or more
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Adds a game to the next group.
+  ///
+  /// @param game   Game that has not started yet; must stay alive until play() returns
+  /// @param source Command source of the game, already reset
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void add(Game &game, CommandSource &source);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Plays all added games until each has ended or its source is exhausted, then forgets them. The
+  /// results are read from the games (Game::getResult()).
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void play();
+
+private:
+  struct Lane
+  {
+    Game *game;
+    CommandSource *source;
+    std::string command; // the "done" waiting for the shared battle phase
+    bool running;
+  };
+
+  std::vector<Lane> lanes;
+  FightBatch batch;
+  NullOutputSink discard;
+
+  bool advance(Lane &lane);
+};
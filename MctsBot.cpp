@@ -0,0 +1,414 @@
+// --------------------------- MctsBot.cpp ---------------------------
+//
+// Implements the MctsBot: root-parallel UCT search with virtual loss,
+// random rollouts and make/unmake on per-thread game copies.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "MctsBot.hpp"
+#include "Game.hpp"
+#include "GreedyBot.hpp"
+#include "MoveGenerator.hpp"
+#include "OutputSink.hpp"
+#include "WorkStealingScheduler.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+  constexpr double REWARD_SCALE = 65536.0; // fixed point of the shared root rewards
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Node of a thread's search tree. Children of a node are stored next to each other.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct Node
+  {
+    Command move; ///< action leading to this node
+    uint32_t firstChild = 0;
+    uint16_t childCount = 0;
+    uint8_t mover = 0; ///< player who plays the action
+    bool expanded = false;
+    uint32_t visits = 0;
+    float reward = 0.0f; ///< summed reward of the mover
+  };
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Statistics of one root action, shared by all threads. pending counts the virtual losses of
+  /// playouts that are still running.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct alignas(64) RootStats
+  {
+    atomic<uint32_t> visits{0};
+    atomic<uint32_t> pending{0};
+    atomic<uint64_t> reward{0};
+  };
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// State of one search shared by its threads.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct SharedSearch
+  {
+    const Game &root;
+    const MoveList &rootMoves;
+    const MctsConfig &config;
+    uint64_t seed;
+    chrono::steady_clock::time_point deadline;
+    vector<RootStats> stats;
+    atomic<uint64_t> playouts{0};
+    atomic<bool> stop{false};
+
+    SharedSearch(const Game &root, const MoveList &rootMoves, const MctsConfig &config, uint64_t seed)
+      : root(root), rootMoves(rootMoves), config(config), seed(seed), stats(rootMoves.size())
+    {
+    }
+  };
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// xorshift64* generator; cheap enough to call once per rollout action.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  class Random
+  {
+  public:
+    explicit Random(uint64_t seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+    uint32_t below(uint32_t bound)
+    {
+      state ^= state >> 12;
+      state ^= state << 25;
+      state ^= state >> 27;
+      return static_cast<uint32_t>(((state * 0x2545F4914F6CDD1Dull) >> 32) * bound >> 32);
+    }
+
+  private:
+    uint64_t state;
+  };
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Reward of player 1 for a state: 1 for a win, 0 for a loss and 0.5 for a tie. Unfinished games
+/// are judged by the health difference.
+///
+/// @param game State to judge
+///
+/// @return Reward in [0, 1]; player 2's reward is 1 minus it
+//---------------------------------------------------------------------------------------------------------------------
+static double playerOneReward(const Game &game)
+{
+  switch (game.getResult())
+  {
+    case GameResult::P1_Wins: return 1.0;
+    case GameResult::P2_Wins: return 0.0;
+    case GameResult::Tie: return 0.5;
+    case GameResult::None: break;
+  }
+  int health1 = max(0, game.getPlayer1().getHealth());
+  int health2 = max(0, game.getPlayer2().getHealth());
+  if (health1 + health2 == 0) return 0.5;
+  return 0.5 + 0.5 * static_cast<double>(health1 - health2) / (health1 + health2);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Plays random actions until the game ends or the ply limit is reached, judges the state and
+/// unmakes the actions again. Each random action ends the turn with probability 1/8, and redraws
+/// are never chosen, since random redraws mostly run the deck out. The given share of actions is
+/// picked by the GreedyBot instead.
+///
+/// @param game          State to play from
+/// @param rng           Random generator of the thread
+/// @param plies         Maximum number of actions
+/// @param greedyPercent Share of actions picked by the GreedyBot (0-100)
+/// @param moves         Scratch move list
+///
+/// @return Reward of player 1
+//---------------------------------------------------------------------------------------------------------------------
+static double rollout(Game &game, Random &rng, int plies, int greedyPercent, MoveList &moves)
+{
+  int made = 0;
+  for (int ply = 0; ply < plies && !game.isGameOver(); ++ply)
+  {
+    generateMoves(game, moves);
+    if (moves.empty()) break;
+    size_t pick = rng.below(static_cast<uint32_t>(moves.size()));
+    if (greedyPercent > 0 && static_cast<int>(rng.below(100)) < greedyPercent)
+    {
+      pick = GreedyBot::choose(game, moves);
+    }
+    else if (rng.below(8) == 0 || moves[pick].verb == Verb::Redraw)
+    {
+      pick = 0;
+      while (moves[pick].verb != Verb::Done) ++pick;
+    }
+    if (game.makeMove(moves[pick]) == CommandStatus::Ok) ++made;
+  }
+
+  double reward = playerOneReward(game);
+  while (made-- > 0) game.unmakeMove();
+  return reward;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Picks the root action of the next playout by UCT over the shared statistics. Running playouts
+/// count as lost visits, so concurrent threads prefer other actions.
+///
+/// @param search Shared search state
+/// @param rng    Random generator of the thread (breaks ties between unvisited actions)
+///
+/// @return Index of the root action
+//---------------------------------------------------------------------------------------------------------------------
+static size_t selectRoot(SharedSearch &search, Random &rng)
+{
+  const size_t count = search.stats.size();
+  uint64_t total = 0;
+  for (const RootStats &stats: search.stats)
+  {
+    total += stats.visits.load(memory_order_relaxed) + stats.pending.load(memory_order_relaxed);
+  }
+  const double logTotal = log(static_cast<double>(max<uint64_t>(total, 1)));
+
+  size_t offset = rng.below(static_cast<uint32_t>(count));
+  size_t best = offset;
+  double bestScore = -1.0;
+  for (size_t k = 0; k < count; ++k)
+  {
+    size_t i = (offset + k) % count;
+    const RootStats &stats = search.stats[i];
+    uint32_t visits = stats.visits.load(memory_order_relaxed) + stats.pending.load(memory_order_relaxed);
+    if (visits == 0) return i;
+    double mean = static_cast<double>(stats.reward.load(memory_order_relaxed)) / REWARD_SCALE / visits;
+    double score = mean + search.config.exploration * sqrt(logTotal / visits);
+    if (score > bestScore)
+    {
+      bestScore = score;
+      best = i;
+    }
+  }
+  return best;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Picks the child of a tree node by UCT. Unvisited children are tried first, in random order.
+///
+/// @param tree   Search tree of the thread
+/// @param parent Expanded node
+/// @param rng    Random generator of the thread
+/// @param c      Exploration constant
+///
+/// @return Index of the child in the tree
+//---------------------------------------------------------------------------------------------------------------------
+static uint32_t selectChild(const vector<Node> &tree, uint32_t parent, Random &rng, double c)
+{
+  const Node &node = tree[parent];
+  const double logVisits = log(static_cast<double>(max<uint32_t>(node.visits, 1)));
+  uint32_t offset = rng.below(node.childCount);
+  uint32_t best = node.firstChild + offset;
+  double bestScore = -1.0;
+  for (uint32_t k = 0; k < node.childCount; ++k)
+  {
+    uint32_t index = node.firstChild + (offset + k) % node.childCount;
+    const Node &child = tree[index];
+    if (child.visits == 0) return index;
+    double score = child.reward / child.visits + c * sqrt(logVisits / child.visits);
+    if (score > bestScore)
+    {
+      bestScore = score;
+      best = index;
+    }
+  }
+  return best;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Search loop of one thread. The thread's tree starts with one node per root action (same order
+/// as the shared statistics); below that it grows by one expansion per playout. Leaves are only
+/// expanded on their second visit, which keeps the tree small for a fixed node budget. The thread
+/// searches its own deal of the hidden cards and drops its tree whenever it deals again.
+///
+/// @param search Shared search state
+/// @param worker Number of the thread (varies the random seed)
+//---------------------------------------------------------------------------------------------------------------------
+static void searchThread(SharedSearch &search, size_t worker)
+{
+  const MctsConfig &config = search.config;
+  const uint8_t rootMover = static_cast<uint8_t>(search.root.getCurrentPlayer().getId());
+
+  NullOutputSink discard;
+  Game game(search.root);
+  game.setOutputSink(discard);
+
+  vector<Node> tree(search.rootMoves.size());
+  for (size_t i = 0; i < tree.size(); ++i)
+  {
+    tree[i].move = search.rootMoves[i];
+    tree[i].mover = rootMover;
+  }
+
+  const uint64_t threadSeed = search.seed + 0x9E3779B97F4A7C15ull * (worker + 1);
+  Random rng(threadSeed);
+  MoveList moves;
+  vector<uint32_t> path;
+  uint64_t threadPlayouts = 0;
+
+  while (!search.stop.load(memory_order_relaxed))
+  {
+    if (config.redealPlayouts > 0 && threadPlayouts % config.redealPlayouts == 0)
+    {
+      game.redealHiddenCards(rootMover, threadSeed ^ (threadPlayouts * 0xD6E8FEB86659FD93ull));
+      tree.resize(search.rootMoves.size());
+      for (Node &rootNode: tree)
+      {
+        rootNode.expanded = false;
+        rootNode.visits = 0;
+        rootNode.reward = 0.0f;
+      }
+    }
+    ++threadPlayouts;
+
+    size_t rootIndex = selectRoot(search, rng);
+    RootStats &stats = search.stats[rootIndex];
+    stats.pending.fetch_add(config.virtualLoss, memory_order_relaxed);
+
+    // Selection and expansion
+    path.clear();
+    uint32_t node = static_cast<uint32_t>(rootIndex);
+    game.makeMove(tree[node].move);
+    path.push_back(node);
+    while (!game.isGameOver())
+    {
+      if (!tree[node].expanded)
+      {
+        if (tree[node].visits == 0) break;
+        generateMoves(game, moves);
+        if (moves.empty() || tree.size() + moves.size() > config.maxNodes) break;
+        uint8_t mover = static_cast<uint8_t>(game.getCurrentPlayer().getId());
+        uint32_t first = static_cast<uint32_t>(tree.size());
+        for (const Command &move: moves)
+        {
+          tree.emplace_back();
+          tree.back().move = move;
+          tree.back().mover = mover;
+        }
+        tree[node].firstChild = first;
+        tree[node].childCount = static_cast<uint16_t>(moves.size());
+        tree[node].expanded = true;
+      }
+      node = selectChild(tree, node, rng, config.exploration);
+      game.makeMove(tree[node].move);
+      path.push_back(node);
+    }
+
+    // Simulation and backpropagation
+    double reward = rollout(game, rng, config.rolloutPlies, config.greedyRolloutPercent, moves);
+    for (uint32_t index: path)
+    {
+      Node &visited = tree[index];
+      ++visited.visits;
+      visited.reward += static_cast<float>(visited.mover == 1 ? reward : 1.0 - reward);
+    }
+    for (size_t i = 0; i < path.size(); ++i) game.unmakeMove();
+
+    double rootReward = (rootMover == 1) ? reward : 1.0 - reward;
+    stats.reward.fetch_add(static_cast<uint64_t>(rootReward * REWARD_SCALE), memory_order_relaxed);
+    stats.visits.fetch_add(1, memory_order_relaxed);
+    stats.pending.fetch_sub(config.virtualLoss, memory_order_relaxed);
+
+    uint64_t playouts = search.playouts.fetch_add(1, memory_order_relaxed) + 1;
+    if ((config.playoutLimit > 0 && playouts >= config.playoutLimit) ||
+        (config.timeLimitMs > 0 && chrono::steady_clock::now() >= search.deadline))
+    {
+      search.stop.store(true, memory_order_relaxed);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Creates a bot.
+///
+/// @param config Search budget and tuning
+//---------------------------------------------------------------------------------------------------------------------
+MctsBot::MctsBot(const MctsConfig &config)
+  : config(config)
+{
+  if (this->config.timeLimitMs <= 0 && this->config.playoutLimit == 0) this->config.playoutLimit = 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Runs the search threads until the budget is used up and picks the most visited root action.
+///
+/// @param game State to search from
+///
+/// @return The chosen action and statistics
+//---------------------------------------------------------------------------------------------------------------------
+MctsResult MctsBot::search(const Game &game) const
+{
+  MctsResult result;
+  auto start = chrono::steady_clock::now();
+
+  MoveList rootMoves;
+  generateMoves(game, rootMoves);
+  if (rootMoves.empty()) return result;
+  result.move = rootMoves[0];
+  if (rootMoves.size() == 1) return result;
+
+  SharedSearch shared(game, rootMoves, config, config.seed + searches * 0xD1B54A32D192ED03ull);
+  shared.deadline = start + chrono::milliseconds(config.timeLimitMs);
+
+  WorkStealingScheduler scheduler(config.threads);
+  scheduler.run(scheduler.getThreadCount(), [&shared](size_t index, unsigned)
+  {
+    searchThread(shared, index);
+  });
+
+  size_t best = 0;
+  for (size_t i = 1; i < rootMoves.size(); ++i)
+  {
+    if (shared.stats[i].visits.load() > shared.stats[best].visits.load()) best = i;
+  }
+  result.move = rootMoves[best];
+  result.playouts = shared.playouts.load();
+  result.visits = shared.stats[best].visits.load();
+  if (result.visits > 0)
+  {
+    result.winRate = static_cast<double>(shared.stats[best].reward.load()) / REWARD_SCALE / result.visits;
+  }
+  result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Searches the current state and formats the chosen action.
+///
+/// @param game    Game asking for a command
+/// @param command Receives the command line
+///
+/// @return false if there is no legal action
+//---------------------------------------------------------------------------------------------------------------------
+bool MctsBot::nextCommand(const Game &game, string &command)
+{
+  if (game.isGameOver()) return false;
+  MctsResult result = search(game);
+  ++searches;
+  command = formatCommand(result.move, game.getCardFactory().getCatalog());
+  return true;
+}
@@ -0,0 +1,115 @@
+// --------------------------- MctsBot.hpp ---------------------------
+//
+// Declares the MctsBot, a computer opponent that picks its actions with a
+// multi-threaded Monte Carlo Tree Search over the real game rules.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Command.hpp"
+#include "CommandSource.hpp"
+
+class Game;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Search budget and tuning of the MctsBot. The search stops when the first limit is reached; a
+/// limit of 0 is disabled (at least one must be set).
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct MctsConfig
+{
+  unsigned threads = 0; ///< search threads (0 selects the hardware concurrency)
+  int timeLimitMs = 200; ///< wall-clock budget per decision
+  uint64_t playoutLimit = 0; ///< playouts per decision, summed over all threads
+  double exploration = 0.7; ///< UCT exploration constant
+  uint32_t virtualLoss = 3; ///< visits a thread adds to the root move it is playing out
+  int rolloutPlies = 160; ///< actions per playout before the health difference decides
+  int greedyRolloutPercent = 0; ///< share of rollout actions picked by the GreedyBot, the rest are random
+  size_t maxNodes = 1 << 18; ///< tree nodes per thread; full trees stop growing
+  uint32_t redealPlayouts = 256; ///< playouts of a thread per deal of the hidden cards (0 searches the true state)
+  uint64_t seed = 0x5EED; ///< base seed of the per-thread random generators
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Outcome of one search.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct MctsResult
+{
+  Command move; ///< the chosen action
+  uint64_t playouts = 0; ///< playouts of all threads
+  uint32_t visits = 0; ///< playouts through the chosen action
+  double winRate = 0.5; ///< average reward of the chosen action for the searching player
+  double seconds = 0.0; ///< wall-clock time of the search
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Computer player for either seat. Every decision is a UCT search from the current state: the
+/// actions of both players (including "done", which runs the battle phase) are tree edges, made and
+/// unmade on a per-thread copy of the game, and every playout finishes with a rollout of random
+/// actions, optionally mixed with GreedyBot choices.
+///
+/// The search is root-parallel: each thread grows its own tree, but the statistics of the root
+/// actions are shared. A thread adds a virtual loss to the root action it is playing out, so the
+/// threads spread over different actions instead of all following the current favourite. The
+/// action with the most playouts is played.
+///
+/// The bot does not cheat: a thread does not search the true state but a deal of the cards the bot
+/// cannot see (see Game::redealHiddenCards), i.e. a random order of both decks and an opponent's
+/// hand dealt from the opponent's hand and deck. Every redealPlayouts playouts the thread deals
+/// again and restarts its tree below the root actions, which only depend on the bot's own cards.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class MctsBot : public CommandSource
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param config Search budget and tuning
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  explicit MctsBot(const MctsConfig &config = MctsConfig());
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Searches the best action of the current player. The game itself is not changed.
+  ///
+  /// @param game State to search from (the game must not be over)
+  ///
+  /// @return The chosen action and search statistics
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  MctsResult search(const Game &game) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Searches and writes the chosen action as a command line.
+  ///
+  /// @param game    Game asking for a command
+  /// @param command Receives the command line
+  ///
+  /// @return false if the game has no legal action
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool nextCommand(const Game &game, std::string &command) override;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return The search configuration
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  const MctsConfig &getConfig() const { return config; }
+
+private:
+  MctsConfig config;
+  uint64_t searches = 0; // decisions made so far, varies the seeds between searches
+};
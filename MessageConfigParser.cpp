@@ -55,6 +55,7 @@ void MessageConfigParser::parseFile(const string &filePath)
   }
 
   // 2) Parse each subsequent non-empty line as KEY:TEXT
+  auto loaded = make_shared<Table>();
   string line;
   while (getline(in, line))
   {
@@ -70,8 +71,30 @@ void MessageConfigParser::parseFile(const string &filePath)
     if (!key.empty() && key.back() == '\r') key.pop_back();
     if (!text.empty() && text.back() == '\r') text.pop_back();
 
-    messages[key] = text;
+    loaded->raw[key] = text;
   }
+
+  // 3) Format every message once: the named table, the per-card tables and the by-name map
+  for (const auto &[key, text]: loaded->raw)
+  {
+    string message = string(getPrefix(key)) + text + "\n";
+    if (key.size() > 2 && key[1] == '_')
+    {
+      if (key[0] == 'I') loaded->cardInfo[key.substr(2)] = message;
+      else if (key[0] == 'D') loaded->cardDescriptions[key.substr(2)] = message;
+    }
+    loaded->formatted[key] = std::move(message);
+  }
+  for (size_t i = 0; i < MESSAGE_KEY_NAMES.size(); ++i)
+  {
+    auto it = loaded->formatted.find(MESSAGE_KEY_NAMES[i]);
+    if (it != loaded->formatted.end())
+    {
+      loaded->byKey[i] = it->second;
+      loaded->present[i] = true;
+    }
+  }
+  table = std::move(loaded);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -83,9 +106,31 @@ void MessageConfigParser::parseFile(const string &filePath)
 /// @return true if the key exists, false otherwise
 ///
 //---------------------------------------------------------------------------------------------------------------------
-bool MessageConfigParser::contains(const string &key) const
+bool MessageConfigParser::contains(string_view key) const
 {
-  return messages.find(key) != messages.end();
+  return table->raw.find(key) != table->raw.end();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Looks a key up in one of the tables.
+///
+/// @param map Table to search
+/// @param key Key to look up
+///
+/// @return The stored text
+///
+/// @throws std::out_of_range if key is not found
+///
+//---------------------------------------------------------------------------------------------------------------------
+string_view MessageConfigParser::lookup(const MessageMap &map, string_view key)
+{
+  auto it = map.find(key);
+  if (it == map.end())
+  {
+    throw out_of_range("Unknown message key: " + string(key));
+  }
+  return it->second;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -99,9 +144,9 @@ bool MessageConfigParser::contains(const string &key) const
 /// @throws std::out_of_range if key is not found
 ///
 //---------------------------------------------------------------------------------------------------------------------
-string MessageConfigParser::getRaw(const string &key) const
+string_view MessageConfigParser::getRaw(string_view key) const
 {
-  return messages.at(key);
+  return lookup(table->raw, key);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -113,11 +158,73 @@ string MessageConfigParser::getRaw(const string &key) const
 /// @return Prefix string such as "[INFO] ", "[ERROR] ", or empty string
 ///
 //---------------------------------------------------------------------------------------------------------------------
-string MessageConfigParser::getPrefix(const string &key) const
+string_view MessageConfigParser::getPrefix(string_view key)
 {
-  if (key.rfind("I_", 0) == 0) return "[INFO] ";
-  if (key.rfind("E_", 0) == 0) return "[ERROR] ";
-  return string();
+  if (key.starts_with("I_")) return "[INFO] ";
+  if (key.starts_with("E_")) return "[ERROR] ";
+  return {};
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the complete formatted message of a named key from the dense table.
+///
+/// @param key Message key
+///
+/// @return Full formatted message with appropriate prefix and newline
+///
+/// @throws std::out_of_range if the key was not in the config file
+///
+//---------------------------------------------------------------------------------------------------------------------
+string_view MessageConfigParser::getMessage(MessageKey key) const
+{
+  size_t index = static_cast<size_t>(key);
+  if (!table->present[index])
+  {
+    throw out_of_range("Unknown message key: " + string(MESSAGE_KEY_NAMES[index]));
+  }
+  return table->byKey[index];
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the raw text of a named key.
+///
+/// @param key Message key
+///
+/// @return Raw message text
+///
+/// @throws std::out_of_range if the key was not in the config file
+///
+//---------------------------------------------------------------------------------------------------------------------
+string_view MessageConfigParser::getRaw(MessageKey key) const
+{
+  return lookup(table->raw, MESSAGE_KEY_NAMES[static_cast<size_t>(key)]);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Fills the "{}" placeholders of a message in order.
+///
+/// @param message Message text
+/// @param values  Values for the placeholders
+///
+/// @return The filled-in message
+///
+//---------------------------------------------------------------------------------------------------------------------
+string MessageConfigParser::fill(string_view message, initializer_list<string> values)
+{
+  string filled;
+  const string *value = values.begin();
+  size_t start = 0;
+  for (size_t at = message.find("{}"); at != string_view::npos; at = message.find("{}", start))
+  {
+    filled.append(message, start, at - start);
+    if (value != values.end()) filled += *value++;
+    start = at + 2;
+  }
+  filled.append(message, start);
+  return filled;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -129,8 +236,35 @@ string MessageConfigParser::getPrefix(const string &key) const
 /// @return Full formatted message with appropriate prefix and newline
 ///
 //---------------------------------------------------------------------------------------------------------------------
-string MessageConfigParser::getMessage(const string &key) const
+string_view MessageConfigParser::getMessage(string_view key) const
+{
+  return lookup(table->formatted, key);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the formatted I_<cardId> message.
+///
+/// @param cardId ID of the card
+///
+/// @return Formatted info message
+///
+//---------------------------------------------------------------------------------------------------------------------
+string_view MessageConfigParser::getCardInfo(string_view cardId) const
+{
+  return lookup(table->cardInfo, cardId);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the formatted D_<cardId> message.
+///
+/// @param cardId ID of the card
+///
+/// @return Formatted descriptive message
+///
+//---------------------------------------------------------------------------------------------------------------------
+string_view MessageConfigParser::getCardDescription(string_view cardId) const
 {
-  const auto &raw = getRaw(key);
-  return getPrefix(key) + raw + "\n";
+  return lookup(table->cardDescriptions, cardId);
 }
@@ -9,11 +9,66 @@
 // ------------------------------------------------------------------------
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 using namespace std; // bring std symbols into this header for brevity
 
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Message keys the game refers to by name. They index a dense table of formatted messages.
+/// Card specific keys (I_<ID>, D_<ID>) are looked up through getCardInfo/getCardDescription.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class MessageKey : uint8_t
+{
+  // errors
+  E_UNKNOWN_COMMAND, E_INVALID_PARAM_COUNT, E_MISSING_CARD, E_INVALID_CARD, E_INVALID_SLOT,
+  E_REDRAW_DISABLED, E_REDRAW_NOT_ENOUGH_CARDS, E_NOT_IN_HAND, E_NOT_CREATURE, E_NOT_SPELL,
+  E_INVALID_PARAM_COUNT_SPELL, E_NOT_IN_FIELD, E_FIELD_EMPTY, E_CREATURE_CANNOT_BATTLE, E_NOT_IN_BATTLE,
+  E_BATTLE_OCCUPIED, E_FIELD_OCCUPIED, E_INVALID_SLOT_SPELL, E_TARGET_EMPTY, E_NOT_IN_GRAVEYARD,
+  E_NOT_ENOUGH_MANA, E_PREVIEW_TOO_LARGE,
+  // info
+  I_MEMRY, I_REVIV, I_BRUTAL, I_CHALLENGER, I_FIRST_STRIKE, I_HASTE, I_LIFESTEAL, I_POISONED, I_REGENERATE,
+  I_TEMPORARY, I_UNDYING, I_VENOMOUS, I_DIRECT, I_FIGHT, I_FILE_WRITE_FAILED,
+  // descriptive
+  D_WELCOME, D_BORDER_A, D_BORDER_B, D_BORDER_C, D_BORDER_D, D_BORDER_GRAVEYARD, D_BORDER_HAND,
+  D_BORDER_INFO, D_BORDER_STATUS, D_BORDER_BATTLE_PHASE, D_ATTACK_1, D_ATTACK_2, D_BORDER_BATTLE_END,
+  D_BORDER_GAME_END, D_END_PLAYER_DEFEATED, D_END_DRAW_CARD, D_END_MAX_ROUNDS, D_TIE, D_BORDER_PREVIEW,
+  D_PREVIEW_ATTACKER, D_PREVIEW_DEFENDER, D_PREVIEW_FIGHT, D_PREVIEW_PLAYER_CHANGE, D_PREVIEW_DIRECT,
+  D_PREVIEW_BLOCKED, D_PREVIEW_SURVIVES, D_PREVIEW_REGENERATES, D_PREVIEW_RETURNS, D_PREVIEW_DIES,
+  D_PREVIEW_EXPIRES, D_PREVIEW_STAYS, D_PREVIEW_UNDYING, D_PREVIEW_CONTINUES, D_PREVIEW_TIE, D_PREVIEW_WINNER,
+  Count
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Config file key of every MessageKey, in enum order.
+///
+//---------------------------------------------------------------------------------------------------------------------
+inline constexpr std::array<std::string_view, static_cast<size_t>(MessageKey::Count)> MESSAGE_KEY_NAMES = {
+  "E_UNKNOWN_COMMAND", "E_INVALID_PARAM_COUNT", "E_MISSING_CARD", "E_INVALID_CARD", "E_INVALID_SLOT",
+  "E_REDRAW_DISABLED", "E_REDRAW_NOT_ENOUGH_CARDS", "E_NOT_IN_HAND", "E_NOT_CREATURE", "E_NOT_SPELL",
+  "E_INVALID_PARAM_COUNT_SPELL", "E_NOT_IN_FIELD", "E_FIELD_EMPTY", "E_CREATURE_CANNOT_BATTLE",
+  "E_NOT_IN_BATTLE", "E_BATTLE_OCCUPIED", "E_FIELD_OCCUPIED", "E_INVALID_SLOT_SPELL", "E_TARGET_EMPTY",
+  "E_NOT_IN_GRAVEYARD", "E_NOT_ENOUGH_MANA", "E_PREVIEW_TOO_LARGE", "I_MEMRY", "I_REVIV", "I_BRUTAL", "I_CHALLENGER",
+  "I_FIRST_STRIKE", "I_HASTE", "I_LIFESTEAL", "I_POISONED", "I_REGENERATE", "I_TEMPORARY", "I_UNDYING",
+  "I_VENOMOUS", "I_DIRECT", "I_FIGHT", "I_FILE_WRITE_FAILED", "D_WELCOME", "D_BORDER_A", "D_BORDER_B",
+  "D_BORDER_C", "D_BORDER_D", "D_BORDER_GRAVEYARD", "D_BORDER_HAND", "D_BORDER_INFO", "D_BORDER_STATUS",
+  "D_BORDER_BATTLE_PHASE", "D_ATTACK_1", "D_ATTACK_2", "D_BORDER_BATTLE_END", "D_BORDER_GAME_END",
+  "D_END_PLAYER_DEFEATED", "D_END_DRAW_CARD", "D_END_MAX_ROUNDS", "D_TIE", "D_BORDER_PREVIEW",
+  "D_PREVIEW_ATTACKER", "D_PREVIEW_DEFENDER", "D_PREVIEW_FIGHT", "D_PREVIEW_PLAYER_CHANGE", "D_PREVIEW_DIRECT",
+  "D_PREVIEW_BLOCKED", "D_PREVIEW_SURVIVES", "D_PREVIEW_REGENERATES", "D_PREVIEW_RETURNS", "D_PREVIEW_DIES",
+  "D_PREVIEW_EXPIRES", "D_PREVIEW_STAYS", "D_PREVIEW_UNDYING", "D_PREVIEW_CONTINUES", "D_PREVIEW_TIE",
+  "D_PREVIEW_WINNER"
+};
+
 //---------------------------------------------------------------------------------------------------------------------
 ///
 /// Class for parsing and retrieving formatted messages from a configuration file.
@@ -28,6 +83,9 @@ using namespace std; // bring std symbols into this header for brevity
 ///  - E_<KEY> → Error message → printed with "[ERROR] "
 ///  - D_<KEY> → Descriptive → no prefix
 ///
+/// Every message is formatted (prefix + text + newline) once while loading. Lookups return views
+/// into that immutable table, which copies of the parser share.
+///
 //---------------------------------------------------------------------------------------------------------------------
 class MessageConfigParser
 {
@@ -52,7 +110,7 @@ public:
   /// @return true if key is present, false otherwise
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  bool contains(const string &key) const;
+  bool contains(string_view key) const;
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -65,24 +123,108 @@ public:
   /// @throws std::out_of_range if the key is not found
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  string getRaw(const string &key) const;
+  string_view getRaw(string_view key) const;
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
-  /// Retrieves the full formatted message (prefix + text + newline).
+  /// Retrieves the full formatted message (prefix + text + newline). Constant time, no allocation.
   ///
   /// @param key The message key
   ///
   /// @return Formatted message with correct prefix and trailing newline
   ///
+  /// @throws std::out_of_range if the key is missing from the config file
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  string_view getMessage(MessageKey key) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Retrieves the raw text of a named key, for messages that are part of a longer line.
+  ///
+  /// @param key The message key
+  ///
+  /// @return Raw message text as stored in the config
+  ///
+  /// @throws std::out_of_range if the key is missing from the config file
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  string_view getRaw(MessageKey key) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Replaces the "{}" placeholders of a message with the given values, in order. Placeholders
+  /// without a value are left out.
+  ///
+  /// @param message Message text, raw or formatted
+  /// @param values  Values for the placeholders
+  ///
+  /// @return The filled-in message
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static string fill(string_view message, initializer_list<string> values);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Retrieves the full formatted message of a key given by name.
+  ///
+  /// @param key The message key
+  ///
+  /// @return Formatted message with correct prefix and trailing newline
+  ///
+  /// @throws std::out_of_range if the key is not found
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  string_view getMessage(string_view key) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Retrieves the formatted I_<cardId> message without building the key.
+  ///
+  /// @param cardId ID of the card (e.g. "CLONE")
+  ///
+  /// @return Formatted info message
+  ///
   /// @throws std::out_of_range if the key is not found
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  string getMessage(const string &key) const;
+  string_view getCardInfo(string_view cardId) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Retrieves the formatted D_<cardId> message without building the key.
+  ///
+  /// @param cardId ID of the card (e.g. "CLONE")
+  ///
+  /// @return Formatted descriptive message
+  ///
+  /// @throws std::out_of_range if the key is not found
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  string_view getCardDescription(string_view cardId) const;
 
 private:
-  // Holds KEY → TEXT mappings
-  unordered_map<string, string> messages;
+  // Hash for string keys that also accepts string_view without converting it
+  struct KeyHash
+  {
+    using is_transparent = void;
+    size_t operator()(string_view key) const { return hash<string_view>{}(key); }
+  };
+
+  using MessageMap = unordered_map<string, string, KeyHash, equal_to<> >;
+
+  // Everything derived from the file; immutable after loading and shared by copies
+  struct Table
+  {
+    MessageMap raw; // KEY -> TEXT as read
+    MessageMap formatted; // KEY -> prefix + TEXT + newline
+    MessageMap cardInfo; // <ID> -> formatted I_<ID>
+    MessageMap cardDescriptions; // <ID> -> formatted D_<ID>
+    array<string, static_cast<size_t>(MessageKey::Count)> byKey; // formatted, in MessageKey order
+    array<bool, static_cast<size_t>(MessageKey::Count)> present{}; // whether byKey entry was in the file
+  };
+
+  shared_ptr<const Table> table;
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -104,5 +246,19 @@ private:
   /// @return Prefix string: "[INFO] ", "[ERROR] ", or "" if descriptive
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  string getPrefix(const string &key) const;
+  static string_view getPrefix(string_view key);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Looks a key up in one of the tables.
+  ///
+  /// @param map Table to search
+  /// @param key Key to look up
+  ///
+  /// @return The stored text
+  ///
+  /// @throws std::out_of_range if the key is not found
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static string_view lookup(const MessageMap &map, string_view key);
 };
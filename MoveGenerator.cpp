@@ -0,0 +1,168 @@
+// --------------------------- MoveGenerator.cpp ---------------------------
+//
+// Implements the legal move generator. The rules mirror the checks in
+// GameActions.cpp; a generated move is always accepted by Game::apply.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "MoveGenerator.hpp"
+#include "Game.hpp"
+
+using namespace std;
+
+namespace
+{
+  // Whether an earlier entry of the list has the same kind (keeps one move per kind)
+  bool seenBefore(const vector<CardHandle> &cards, size_t position, const CardPool &pool)
+  {
+    CardKind kind = pool.get(cards[position])->getKind();
+    for (size_t i = 0; i < position; ++i)
+    {
+      if (pool.get(cards[i])->getKind() == kind) return true;
+    }
+    return false;
+  }
+
+  Command makeMove(Verb verb, CardKind card = NO_CARD_KIND)
+  {
+    Command move;
+    move.verb = verb;
+    move.card = card;
+    return move;
+  }
+
+  Slot makeSlot(SlotZone zone, int index, bool opponent = false)
+  {
+    Slot slot;
+    slot.zone = zone;
+    slot.opponent = opponent;
+    slot.index = static_cast<int8_t>(index);
+    return slot;
+  }
+
+  // Mana a target spell costs on a creature (X costs depend on the target)
+  int targetSpellCost(const Card &spell, const Card &target)
+  {
+    int manaCost = spell.getManaCost();
+    if (manaCost == -1)
+    {
+      SpellEffect effect = spell.getDefinition().effect;
+      if (effect == SpellEffect::Curse) manaCost = target.getManaCost() + 1;
+      else if (effect == SpellEffect::Clone) manaCost = (target.getManaCost() + 1) / 2;
+    }
+    return manaCost;
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Enumerates the legal actions of the current player.
+///
+/// @param game  Game to inspect
+/// @param moves Receives the moves
+///
+//---------------------------------------------------------------------------------------------------------------------
+void generateMoves(const Game &game, MoveList &moves)
+{
+  moves.clear();
+  if (game.isGameOver()) return;
+
+  const Player &player = game.getCurrentPlayer();
+  const Board &board = game.getBoard();
+  const CardPool &pool = game.getCardFactory().getPool();
+  const bool firstPlayer = (player.getId() == 1);
+  const Zone &ownField = firstPlayer ? board.attackerField() : board.defenderField();
+  const Zone &ownBattle = firstPlayer ? board.attackerBattle() : board.defenderBattle();
+  const Zone &enemyField = firstPlayer ? board.defenderField() : board.attackerField();
+  const Zone &enemyBattle = firstPlayer ? board.defenderBattle() : board.attackerBattle();
+  const int mana = player.getMana();
+
+  moves.push(makeMove(Verb::Done));
+  if (player.canRedraw()) moves.push(makeMove(Verb::Redraw));
+
+  // Creatures from hand into empty field slots
+  const vector<CardHandle> &hand = player.getHand();
+  for (size_t h = 0; h < hand.size(); ++h)
+  {
+    const Card *card = pool.get(hand[h]);
+    if (card->getType() != CardType::Creature || card->getManaCost() > mana || seenBefore(hand, h, pool)) continue;
+    for (int i = 0; i < 7; ++i)
+    {
+      if (ownField.getHandle(i) != NO_CARD) continue;
+      Command move = makeMove(Verb::Creature, card->getKind());
+      move.source = makeSlot(SlotZone::Field, i);
+      moves.push(move);
+    }
+  }
+
+  // Field creatures that may battle into empty battle slots
+  for (int i = 0; i < 7; ++i)
+  {
+    const CreatureCard *creature = pool.getCreature(ownField.getHandle(i));
+    if (!creature) continue;
+    if (creature->getSummonedRound() == game.getCurrentRound() && !creature->hasTrait(Trait::Haste)) continue;
+    for (int j = 0; j < 7; ++j)
+    {
+      if (ownBattle.getHandle(j) != NO_CARD) continue;
+      Command move = makeMove(Verb::Battle);
+      move.source = makeSlot(SlotZone::Field, i);
+      move.target = makeSlot(SlotZone::Battle, j);
+      moves.push(move);
+    }
+  }
+
+  // Spells
+  const vector<CardHandle> &graveyard = player.getGraveyard();
+  for (size_t h = 0; h < hand.size(); ++h)
+  {
+    const Card *card = pool.get(hand[h]);
+    if (card->getType() != CardType::Spell || card->getManaCost() > mana || seenBefore(hand, h, pool)) continue;
+    const CardDefinition &spell = card->getDefinition();
+
+    if (spell.spellType == SpellType::General)
+    {
+      moves.push(makeMove(Verb::Spell, spell.kind));
+    }
+    else if (spell.spellType == SpellType::Target)
+    {
+      const Zone *zones[4] = {&ownField, &ownBattle, &enemyField, &enemyBattle};
+      for (int z = 0; z < 4; ++z)
+      {
+        for (int i = 0; i < 7; ++i)
+        {
+          const Card *target = pool.get(zones[z]->getHandle(i));
+          if (!target || target->getType() != CardType::Creature || targetSpellCost(*card, *target) > mana) continue;
+          Command move = makeMove(Verb::Spell, spell.kind);
+          move.targetCount = 1;
+          move.target = makeSlot((z % 2 == 0) ? SlotZone::Field : SlotZone::Battle, i, z >= 2);
+          moves.push(move);
+        }
+      }
+    }
+    else
+    {
+      // One move per creature kind; the engine picks the most recent card of that kind
+      for (size_t g = graveyard.size(); g-- > 0;)
+      {
+        const CreatureCard *dead = pool.getCreature(graveyard[g]);
+        if (!dead) continue;
+        bool newerOfSameKind = false;
+        for (size_t k = g + 1; k < graveyard.size(); ++k)
+        {
+          newerOfSameKind = newerOfSameKind || pool.get(graveyard[k])->getKind() == dead->getKind();
+        }
+        if (newerOfSameKind) continue;
+        int manaCost = 0;
+        if (spell.effect == SpellEffect::HeroicMemory) manaCost = (dead->getManaCost() + 1) / 2;
+        else if (spell.effect == SpellEffect::Revive) manaCost = 2;
+        if (manaCost > mana) continue;
+        Command move = makeMove(Verb::Spell, spell.kind);
+        move.targetCount = 1;
+        move.graveyardTarget = dead->getKind();
+        moves.push(move);
+      }
+    }
+  }
+}
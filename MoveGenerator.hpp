@@ -0,0 +1,72 @@
+// --------------------------- MoveGenerator.hpp ---------------------------
+//
+// Declares the legal move generator, which lists every action the current
+// player may take in the setup phase as Commands for Game::apply.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "Command.hpp"
+
+class Game;
+
+constexpr size_t MAX_MOVES = 1024; // capacity of a MoveList
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Fixed-capacity list of commands. It lives wherever the caller puts it (usually the stack), so
+/// generating moves never allocates.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class MoveList
+{
+public:
+  void clear() { count = 0; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Appends a move unless the list is full.
+  ///
+  /// @param move Move to append
+  ///
+  /// @return false if the list was full and the move was dropped
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool push(const Command &move)
+  {
+    if (count == MAX_MOVES) return false;
+    moves[count++] = move;
+    return true;
+  }
+
+  size_t size() const { return count; }
+
+  bool empty() const { return count == 0; }
+
+  const Command &operator[](size_t index) const { return moves[index]; }
+
+  const Command *begin() const { return moves.data(); }
+
+  const Command *end() const { return moves.data() + count; }
+
+private:
+  std::array<Command, MAX_MOVES> moves;
+  size_t count = 0;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Lists every action Game::apply would accept from the current player, in a fixed order: done,
+/// redraw, creatures, battle moves, spells. Identical hand cards yield one move, and graveyard
+/// spells get one move per creature kind in the graveyard. Nothing is printed or allocated.
+///
+/// @param game  Game to inspect
+/// @param moves Receives the moves (cleared first; nothing if the game is over)
+///
+//---------------------------------------------------------------------------------------------------------------------
+void generateMoves(const Game &game, MoveList &moves);
@@ -0,0 +1,118 @@
+// --------------------------- OutputSink.cpp ---------------------------
+//
+// Implements the buffered and console output sinks.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "OutputSink.hpp"
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the console sink. It is created on first use and flushed when the program exits.
+///
+/// @return Reference to the buffered sink writing to std::cout
+///
+//---------------------------------------------------------------------------------------------------------------------
+OutputSink &OutputSink::console()
+{
+  static BufferedOutputSink sink(cout);
+  return sink;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Allocates the buffer and points the put area of the stream at it.
+///
+/// @param target   Stream the buffered text is written to
+/// @param capacity Size of the buffer in bytes
+///
+//---------------------------------------------------------------------------------------------------------------------
+BufferedOutputSink::BufferedOutputSink(ostream &target, size_t capacity)
+  : target(target),
+    buffer(capacity > 0 ? capacity : 1),
+    out(this)
+{
+  setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+BufferedOutputSink::~BufferedOutputSink()
+{
+  flush();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Writes the buffered text and flushes the target stream.
+///
+//---------------------------------------------------------------------------------------------------------------------
+void BufferedOutputSink::flush()
+{
+  drain();
+  target.flush();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Writes the buffered text to the target stream and resets the put area.
+///
+//---------------------------------------------------------------------------------------------------------------------
+void BufferedOutputSink::drain()
+{
+  if (pptr() > pbase())
+  {
+    target.write(pbase(), pptr() - pbase());
+  }
+  setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Called when the buffer is full: drains it and stores the pending character.
+///
+/// @param ch Character that did not fit, or EOF
+///
+/// @return ch on success
+///
+//---------------------------------------------------------------------------------------------------------------------
+BufferedOutputSink::int_type BufferedOutputSink::overflow(int_type ch)
+{
+  drain();
+  if (!traits_type::eq_int_type(ch, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Copies a block of text into the buffer. Blocks larger than the whole buffer bypass it.
+///
+/// @param text  Characters to write
+/// @param count Number of characters
+///
+/// @return count
+///
+//---------------------------------------------------------------------------------------------------------------------
+streamsize BufferedOutputSink::xsputn(const char *text, streamsize count)
+{
+  if (count > epptr() - pptr())
+  {
+    drain();
+    if (count > epptr() - pptr())
+    {
+      target.write(text, count);
+      return count;
+    }
+  }
+  memcpy(pptr(), text, static_cast<size_t>(count));
+  pbump(static_cast<int>(count));
+  return count;
+}
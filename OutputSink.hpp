@@ -0,0 +1,124 @@
+// --------------------------- OutputSink.hpp ---------------------------
+//
+// Declares the OutputSink interface through which a Game writes all of its
+// text, a buffered sink that forwards to a stream in large chunks and a
+// null sink that discards everything.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Destination of game output. Text is formatted into stream(); flush() is called whenever the
+/// game waits for input, so a sink may hold text back until then.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class OutputSink
+{
+public:
+  virtual ~OutputSink() = default;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Stream the game formats its output into
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  virtual std::ostream &stream() = 0;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Makes all text written so far visible at the destination.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  virtual void flush() {}
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return true if the sink throws all text away, so the game may skip producing it
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  virtual bool discards() const { return false; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Returns the process-wide buffered sink writing to std::cout, used by interactive games.
+  ///
+  /// @return Reference to the console sink
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static OutputSink &console();
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Collects output in a fixed-size buffer and hands it to the target stream only when the buffer
+/// is full or flush() is called. std::endl on stream() does not reach the target, so a whole
+/// battle phase is written with a single call.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class BufferedOutputSink : public OutputSink, private std::streambuf
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param target   Stream the buffered text is written to (must outlive the sink)
+  /// @param capacity Size of the buffer in bytes
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  explicit BufferedOutputSink(std::ostream &target, size_t capacity = 1 << 16);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Flushes the remaining text to the target.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  ~BufferedOutputSink() override;
+
+  BufferedOutputSink(const BufferedOutputSink &) = delete;
+  BufferedOutputSink &operator=(const BufferedOutputSink &) = delete;
+
+  std::ostream &stream() override { return out; }
+
+  void flush() override;
+
+private:
+  int_type overflow(int_type ch) override;
+  std::streamsize xsputn(const char *text, std::streamsize count) override;
+  int sync() override { return 0; } // std::endl must not force a write
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Writes the buffered text to the target stream and empties the buffer.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void drain();
+
+  std::ostream &target;
+  std::vector<char> buffer;
+  std::ostream out;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Discards all output. The stream has no buffer, so insertions fail before any formatting.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class NullOutputSink : public OutputSink
+{
+public:
+  NullOutputSink() : out(nullptr) {}
+
+  std::ostream &stream() override { return out; }
+
+  bool discards() const override { return true; }
+
+private:
+  std::ostream out;
+};
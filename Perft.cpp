@@ -0,0 +1,136 @@
+// --------------------------- Perft.cpp ---------------------------
+//
+// Implements the perft benchmark on top of the move generator.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "Perft.hpp"
+#include "Game.hpp"
+#include "MoveGenerator.hpp"
+#include "OutputSink.hpp"
+#include "TranspositionTable.hpp"
+#include "WorkStealingScheduler.hpp"
+#include <chrono>
+#include <ostream>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Prints the breakdown and the total, and the throughput on its own stream.
+///
+/// @param os     Stream for the counts
+/// @param timing Stream for the timing line
+///
+//---------------------------------------------------------------------------------------------------------------------
+void PerftReport::print(ostream &os, ostream &timing) const
+{
+  for (const PerftEntry &entry: moves)
+  {
+    os << entry.move << ": " << entry.nodes << "\n";
+  }
+  os << "\nNodes searched (depth " << depth << "): " << nodes << "\n";
+  os.flush();
+  timing << "Time: " << seconds << " s (" << nodesPerSecond() << " nodes/s)\n";
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Counts the leaf nodes below a state by making and unmaking every move. At depth 1 the moves
+/// are counted without playing them.
+///
+/// @param game  State to count from
+/// @param depth Number of actions
+/// @param table Table of known subtree counts, or nullptr
+///
+/// @return Number of action sequences of that length
+///
+//---------------------------------------------------------------------------------------------------------------------
+uint64_t perft(Game &game, int depth, TranspositionTable *table)
+{
+  if (depth <= 0) return 1;
+
+  MoveList moves;
+  generateMoves(game, moves);
+  if (depth == 1) return moves.size();
+
+  uint64_t hash = 0;
+  if (table)
+  {
+    hash = game.stateHash();
+    TTData known;
+    if (table->probe(hash, known) && known.depth == depth && known.bound == TTBound::Exact)
+    {
+      return static_cast<uint32_t>(known.value);
+    }
+  }
+
+  uint64_t nodes = 0;
+  for (const Command &move: moves)
+  {
+    game.makeMove(move);
+    nodes += perft(game, depth - 1, table);
+    game.unmakeMove();
+  }
+
+  // Counts that do not fit the 32-bit value of an entry are not stored
+  if (table && nodes <= INT32_MAX)
+  {
+    TTData result;
+    result.value = static_cast<int32_t>(nodes);
+    result.depth = static_cast<uint8_t>(depth);
+    result.bound = TTBound::Exact;
+    table->store(hash, result);
+  }
+  return nodes;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Runs perft one root move at a time so each move's subtree is reported. Every root move is a
+/// task of its own with a private copy of the game.
+///
+/// @param game    State to count from
+/// @param depth   Number of actions
+/// @param table   Shared table of known subtree counts, or nullptr
+/// @param threads Number of threads
+///
+/// @return The report
+///
+//---------------------------------------------------------------------------------------------------------------------
+PerftReport perftDivide(const Game &game, int depth, TranspositionTable *table, unsigned threads)
+{
+  PerftReport report;
+  report.depth = depth;
+
+  NullOutputSink discard;
+  Game root(game);
+  root.setOutputSink(discard);
+  const CardCatalog &catalog = root.getCardFactory().getCatalog();
+
+  auto start = chrono::steady_clock::now();
+  MoveList moves;
+  generateMoves(root, moves);
+  report.moves.resize(moves.size());
+  for (size_t i = 0; i < moves.size(); ++i)
+  {
+    report.moves[i].move = formatCommand(moves[i], catalog);
+  }
+
+  WorkStealingScheduler scheduler(threads);
+  scheduler.run(moves.size(), [&](size_t index, unsigned)
+  {
+    Game branch(root);
+    branch.makeMove(moves[index]);
+    report.moves[index].nodes = perft(branch, depth - 1, table);
+  });
+
+  for (const PerftEntry &entry: report.moves)
+  {
+    report.nodes += entry.nodes;
+  }
+  report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  return report;
+}
@@ -0,0 +1,95 @@
+// --------------------------- Perft.hpp ---------------------------
+//
+// Declares the perft benchmark, which counts the action sequences that
+// can be played from a game state up to a fixed depth.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class Game;
+class TranspositionTable;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Node count below one root move.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct PerftEntry
+{
+  std::string move; ///< the move as a command line
+  uint64_t nodes = 0; ///< leaf nodes reached through the move
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Result of a perft run: the per-move breakdown, the total and the time it took.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct PerftReport
+{
+  int depth = 0; ///< searched depth in actions
+  uint64_t nodes = 0; ///< leaf nodes at that depth
+  double seconds = 0.0; ///< wall-clock time of the search
+  std::vector<PerftEntry> moves; ///< breakdown by root move, in generation order
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Leaf nodes per second (0 if no time was measured)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  double nodesPerSecond() const { return seconds > 0.0 ? static_cast<double>(nodes) / seconds : 0.0; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Prints one "<move>: <nodes>" line per root move and the total, then the timing on a separate
+  /// stream. The counts are deterministic, so two runs (or a test) can diff them.
+  ///
+  /// @param os     Stream for the counts
+  /// @param timing Stream for the timing line
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void print(std::ostream &os, std::ostream &timing) const;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Counts the leaf nodes of the action tree of the given depth. Every legal action (see
+/// generateMoves) is one ply, including "done", so the tree continues through battle phases into
+/// later rounds. Finished games are dead ends and count nothing below depth 0. The moves are made
+/// and unmade on the game itself, which is back in its original state afterwards.
+///
+/// With a transposition table, the count of every subtree is stored under its state hash, so
+/// positions reached through different action orders are counted once.
+///
+/// @param game  State to count from; its output sink should discard output
+/// @param depth Number of actions
+/// @param table Table shared by all threads, or nullptr
+///
+/// @return Number of action sequences of exactly that length
+///
+//---------------------------------------------------------------------------------------------------------------------
+uint64_t perft(Game &game, int depth, TranspositionTable *table = nullptr);
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Runs perft with a breakdown by root move and measures the time. All output of the game is
+/// discarded during the run. The root moves are counted in parallel, each on its own copy of the
+/// game; the threads share the transposition table.
+///
+/// @param game    State to count from
+/// @param depth   Number of actions (at least 1)
+/// @param table   Table shared by all threads, or nullptr
+/// @param threads Number of threads (0 selects the hardware concurrency)
+///
+/// @return The report
+///
+//---------------------------------------------------------------------------------------------------------------------
+PerftReport perftDivide(const Game &game, int depth, TranspositionTable *table = nullptr, unsigned threads = 1);
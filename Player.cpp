@@ -7,11 +7,13 @@
 // Author: Miloš Đukarić, Florian Kerman, Stefan Jović
 // ------------------------------------------------------------------------
 #include "Player.hpp"
-#include "Deck.hpp"
 #include "CreatureCard.hpp"
 #include "Card.hpp"
+#include "StateHash.hpp"
+#include "UndoJournal.hpp"
 
 #include <algorithm>
+#include <random>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -37,28 +39,12 @@ Player::Player(int playerId, int startHealth, int manaPoolStart)
 {
 }
 
-//---------------------------------------------------------------------------------------------------------------------
-///
-/// Sets the player's deck from an external Deck object (copies pointers).
-///
-/// @param d The Deck to copy cards from
-///
-//---------------------------------------------------------------------------------------------------------------------
-void Player::setDeck(Deck &d)
-{
-  deck.clear();
-  for (auto &ptr: d.getCards())
-  {
-    deck.push_back(ptr); // shared_ptr<Card>
-  }
-}
-
 //---------------------------------------------------------------------------------------------------------------------
 int Player::getId() const { return id; }
 int Player::getHealth() const { return health; }
 int Player::getMana() const { return mana; }
 int Player::getManaPoolSize() const { return manaPoolSize; }
-size_t Player::getDeckRemaining() const { return deck.size(); }
+size_t Player::getDeckRemaining() const { return deck.remaining(); }
 //---------------------------------------------------------------------------------------------------------------------
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -69,11 +55,11 @@ size_t Player::getDeckRemaining() const { return deck.size(); }
 //---------------------------------------------------------------------------------------------------------------------
 void Player::drawCard()
 {
-  if (!deck.empty())
+  if (!deck.isEmpty())
   {
-    std::shared_ptr<Card> top = deck.front();
-    deck.erase(deck.begin());
-    hand.push_back(top);
+    hand.push_back(deck.draw());
+    if (journal) journal->inserted(hand, hand.size() - 1);
+    if (hash) hash->toggle(HashFeature::CardInHand, hand.back(), id);
   }
 }
 
@@ -94,25 +80,21 @@ void Player::drawMultiple(int n)
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
-/// Searches for a card in hand by ID (case-insensitive).
+/// Searches for a card of the given kind in hand.
 ///
-/// @param id The card ID to search for
+/// @param kind The interned card kind to search for
 ///
-/// @return Pointer to the card if found, nullptr otherwise
+/// @return Pointer to the first matching card if found, nullptr otherwise
 ///
 //---------------------------------------------------------------------------------------------------------------------
-Card *Player::findCardInHandById(const std::string &id)
+Card *Player::findCardInHand(CardKind kind)
 {
-  std::string upperId = id;
-  std::transform(upperId.begin(), upperId.end(), upperId.begin(), ::toupper);
-
-  for (const auto &c: hand)
+  for (CardHandle c: hand)
   {
-    std::string cardId = c->getID();
-    std::transform(cardId.begin(), cardId.end(), cardId.begin(), ::toupper);
-    if (cardId == upperId)
+    Card *card = pool->get(c);
+    if (card->getKind() == kind)
     {
-      return c.get();
+      return card;
     }
   }
   return nullptr;
@@ -137,6 +119,8 @@ bool Player::canRedraw() const
 //---------------------------------------------------------------------------------------------------------------------
 void Player::disableRedraw()
 {
+  if (journal) journal->save(redrawEnabled);
+  if (hash && redrawEnabled) hash->toggle(HashFeature::PlayerRedraw, id, 0);
   redrawEnabled = false;
 }
 
@@ -147,9 +131,14 @@ void Player::disableRedraw()
 //---------------------------------------------------------------------------------------------------------------------
 void Player::returnHandToBottomOfDeck()
 {
-  for (auto &card: hand)
+  for (CardHandle card: hand)
+  {
+    if (hash) hash->toggle(HashFeature::CardInHand, card, id);
+    deck.pushBottom(card);
+  }
+  if (journal)
   {
-    deck.push_back(card);
+    for (size_t i = hand.size(); i-- > 0;) journal->erasing(hand, i);
   }
   hand.clear();
 }
@@ -180,12 +169,14 @@ void Player::performRedraw()
 void Player::removeCardFromHand(Card *card)
 {
   auto it = std::find_if(hand.begin(), hand.end(),
-                         [card](const shared_ptr<Card> &ptr)
+                         [this, card](CardHandle ptr)
                          {
-                           return ptr.get() == card;
+                           return pool->get(ptr) == card;
                          });
   if (it != hand.end())
   {
+    if (journal) journal->erasing(hand, static_cast<size_t>(it - hand.begin()));
+    if (hash) hash->toggle(HashFeature::CardInHand, *it, id);
     hand.erase(it);
   }
 }
@@ -199,6 +190,8 @@ void Player::removeCardFromHand(Card *card)
 //---------------------------------------------------------------------------------------------------------------------
 void Player::subtractMana(int amount)
 {
+  if (journal) journal->save(mana);
+  if (hash) hash->change(HashFeature::PlayerMana, id, static_cast<uint32_t>(mana), static_cast<uint32_t>(mana - amount));
   mana -= amount;
 }
 
@@ -206,44 +199,57 @@ void Player::subtractMana(int amount)
 ///
 /// Adds a creature card to the player's graveyard.
 ///
-/// @param creature Pointer to the creature card
+/// @param creature Handle of the creature card
 ///
 //---------------------------------------------------------------------------------------------------------------------
-void Player::addToGraveyard(std::shared_ptr<CreatureCard> creature)
+void Player::addToGraveyard(CardHandle creature)
 {
   graveyard.push_back(creature);
+  if (journal) journal->inserted(graveyard, graveyard.size() - 1);
+  if (hash) hash->toggle(HashFeature::CardInGraveyard, creature, id);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
 /// Adds a card to the player's hand.
 ///
-/// @param card Shared pointer to the card
+/// @param card Handle of the card
 ///
 //---------------------------------------------------------------------------------------------------------------------
-void Player::addCardToHand(std::shared_ptr<Card> card)
+void Player::addCardToHand(CardHandle card)
 {
-  hand.push_back(std::move(card));
+  hand.push_back(card);
+  if (journal) journal->inserted(hand, hand.size() - 1);
+  if (hash) hash->toggle(HashFeature::CardInHand, card, id);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
-/// Returns a reference to the graveyard (modifiable).
+/// Removes the most recent occurrence of a card from the graveyard.
 ///
-/// @return Reference to vector of creature pointers
+/// @param card Handle of the card to remove
 ///
 //---------------------------------------------------------------------------------------------------------------------
-std::vector<std::shared_ptr<CreatureCard> > &Player::getMutableGraveyard()
+void Player::removeLastFromGraveyard(CardHandle card)
 {
-  return graveyard;
+  auto it = std::find(graveyard.rbegin(), graveyard.rend(), card);
+  if (it != graveyard.rend())
+  {
+    size_t index = static_cast<size_t>(graveyard.rend() - it) - 1;
+    if (journal) journal->erasing(graveyard, index);
+    if (hash) hash->toggle(HashFeature::CardInGraveyard, card, id);
+    graveyard.erase(graveyard.begin() + index);
+  }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
 /// Prints the player's hand in ASCII visual style.
 ///
+/// @param os Stream the hand is written to
+///
 //---------------------------------------------------------------------------------------------------------------------
-void Player::printHand() const
+void Player::printHand(ostream &os) const
 {
   const int maxPerRow = 7;
 
@@ -252,83 +258,100 @@ void Player::printHand() const
     size_t end = min(i + maxPerRow, hand.size());
 
     // Mana cost
-    cout << "    ";
+    os << "    ";
     for (size_t j = i; j < end; ++j)
     {
-      int cost = hand[j]->getManaCost();
+      int cost = pool->get(hand[j])->getManaCost();
       string mc = (cost < 0) ? "XX" : (cost > 99 ? "**" : (cost < 10 ? "0" + to_string(cost) : to_string(cost)));
-      cout << " _____M" << mc;
-      if (j != end - 1) cout << "   ";
+      os << " _____M" << mc;
+      if (j != end - 1) os << "   ";
     }
-    cout << "\n";
+    os << "\n";
 
     // Card ID
-    cout << "    ";
+    os << "    ";
     for (size_t j = i; j < end; ++j)
     {
-      cout << "| " << setw(5) << left << hand[j]->getID() << " |";
-      if (j != end - 1) cout << "   ";
+      os << "| " << setw(5) << left << pool->get(hand[j])->getID() << " |";
+      if (j != end - 1) os << "   ";
     }
-    cout << "\n";
+    os << "\n";
 
     // Traits or blank
-    cout << "    ";
+    os << "    ";
     for (size_t j = i; j < end; ++j)
     {
-      if (hand[j]->getType() == CardType::Creature)
+      if (CreatureCard *c = pool->getCreature(hand[j]))
       {
-        CreatureCard *c = dynamic_cast<CreatureCard *>(hand[j].get());
         string traits = c->getTraitsString();
         traits.resize(5, ' ');
         if (traits.size() > 5) traits = traits.substr(0, 4) + "+";
-        cout << "| " << traits << " |";
+        os << "| " << traits << " |";
       }
       else
       {
-        cout << "|       |";
+        os << "|       |";
       }
-      if (j != end - 1) cout << "   ";
+      if (j != end - 1) os << "   ";
     }
-    cout << "\n";
+    os << "\n";
 
     // Bottom line (ATK/HP or blanks)
-    cout << "    ";
+    os << "    ";
     for (size_t j = i; j < end; ++j)
     {
-      if (hand[j]->getType() == CardType::Creature)
+      if (CreatureCard *c = pool->getCreature(hand[j]))
       {
-        CreatureCard *c = dynamic_cast<CreatureCard *>(hand[j].get());
         string atk = (c->getAttack() > 99)
                        ? "**"
                        : (c->getAttack() < 10 ? "0" + to_string(c->getAttack()) : to_string(c->getAttack()));
         string hp = (c->getHealth() > 99)
                       ? "**"
                       : (c->getHealth() < 10 ? "0" + to_string(c->getHealth()) : to_string(c->getHealth()));
-        cout << "A" << atk << "___H" << hp;
+        os << "A" << atk << "___H" << hp;
       }
       else
       {
-        cout << " _______ ";
+        os << " _______ ";
       }
-      if (j != end - 1) cout << "   ";
+      if (j != end - 1) os << "   ";
     }
-    cout << "\n";
+    os << "\n";
   }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
-/// Removes a creature card from the graveyard based on ID match.
+/// Removes a creature card from the graveyard based on kind match.
 ///
-/// @param card Pointer to the card to remove
+/// @param card Handle of the card to remove
 ///
 //---------------------------------------------------------------------------------------------------------------------
-void Player::removeFromGraveyard(std::shared_ptr<CreatureCard> card)
+void Player::removeFromGraveyard(CardHandle card)
 {
+  CardKind kind = pool->get(card)->getKind();
+  if (hash)
+  {
+    for (CardHandle c: graveyard)
+    {
+      if (pool->get(c)->getKind() == kind) hash->toggle(HashFeature::CardInGraveyard, c, id);
+    }
+  }
+  if (journal && journal->isRecording())
+  {
+    // Erase one by one from the back, so every removal can be recorded
+    for (size_t i = graveyard.size(); i-- > 0;)
+    {
+      if (pool->get(graveyard[i])->getKind() != kind) continue;
+      journal->erasing(graveyard, i);
+      graveyard.erase(graveyard.begin() + i);
+    }
+    return;
+  }
   graveyard.erase(std::remove_if(graveyard.begin(), graveyard.end(),
-                                 [&](const std::shared_ptr<CreatureCard> &c)
+                                 [&](CardHandle c)
                                  {
-                                   return c->getID() == card->getID();
+                                   return pool->get(c)->getKind() == kind;
                                  }), graveyard.end());
 }
 
@@ -341,7 +364,10 @@ void Player::removeFromGraveyard(std::shared_ptr<CreatureCard> card)
 //---------------------------------------------------------------------------------------------------------------------
 void Player::setHealth(int newHealth)
 {
+  if (journal) journal->save(health);
+  int oldHealth = health;
   health = max(0, newHealth);
+  if (hash) hash->change(HashFeature::PlayerHealth, id, static_cast<uint32_t>(oldHealth), static_cast<uint32_t>(health));
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -353,7 +379,10 @@ void Player::setHealth(int newHealth)
 //---------------------------------------------------------------------------------------------------------------------
 void Player::setMana(int newMana)
 {
+  if (journal) journal->save(mana);
+  int oldMana = mana;
   mana = clamp(newMana, 0, manaPoolSize);
+  if (hash) hash->change(HashFeature::PlayerMana, id, static_cast<uint32_t>(oldMana), static_cast<uint32_t>(mana));
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -365,7 +394,13 @@ void Player::setMana(int newMana)
 //---------------------------------------------------------------------------------------------------------------------
 void Player::setManaPoolSize(int newSize)
 {
+  if (journal) journal->save(manaPoolSize);
+  int oldSize = manaPoolSize;
   manaPoolSize = max(0, newSize);
+  if (hash)
+  {
+    hash->change(HashFeature::PlayerManaPool, id, static_cast<uint32_t>(oldSize), static_cast<uint32_t>(manaPoolSize));
+  }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -375,7 +410,7 @@ void Player::setManaPoolSize(int newSize)
 /// @return Const reference to hand vector
 ///
 //---------------------------------------------------------------------------------------------------------------------
-const vector<shared_ptr<Card> > &Player::getHand() const
+const vector<CardHandle> &Player::getHand() const
 {
   return hand;
 }
@@ -387,24 +422,125 @@ const vector<shared_ptr<Card> > &Player::getHand() const
 /// @return Const reference to graveyard vector
 ///
 //---------------------------------------------------------------------------------------------------------------------
-const std::vector<std::shared_ptr<CreatureCard> > &Player::getGraveyard() const
+const std::vector<CardHandle> &Player::getGraveyard() const
 {
   return graveyard;
 }
 
-std::shared_ptr<Card> Player::extractCardFromHand(Card *rawPtr)
+CardHandle Player::extractCardFromHand(Card *rawPtr)
 {
   auto it = std::find_if(hand.begin(), hand.end(),
-                         [rawPtr](const std::shared_ptr<Card> &c)
+                         [this, rawPtr](CardHandle c)
                          {
-                           return c.get() == rawPtr;
+                           return pool->get(c) == rawPtr;
                          });
 
   if (it != hand.end())
   {
-    auto extracted = *it;
+    CardHandle extracted = *it;
+    if (journal) journal->erasing(hand, static_cast<size_t>(it - hand.begin()));
+    if (hash) hash->toggle(HashFeature::CardInHand, *it, id);
     hand.erase(it);
     return extracted;
   }
-  return nullptr;
+  return NO_CARD;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Writes the player's state into a snapshot. Deck (top first), hand and graveyard are stored one
+/// after the other in state.cards.
+///
+/// @param state Snapshot of this player
+///
+/// @return false if a list or a handle does not fit the snapshot
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool Player::saveState(PlayerState &state) const
+{
+  size_t total = deck.remaining() + hand.size() + graveyard.size();
+  if (total > MAX_STATE_CARDS) return false;
+
+  state.health = health;
+  state.mana = mana;
+  state.manaPoolSize = manaPoolSize;
+  state.redrawEnabled = redrawEnabled;
+  state.deckSequence = deck.getFirstSequence();
+  state.deckCount = static_cast<uint8_t>(deck.remaining());
+  state.handCount = static_cast<uint8_t>(hand.size());
+  state.graveyardCount = static_cast<uint8_t>(graveyard.size());
+
+  size_t next = 0;
+  for (size_t i = 0; i < deck.remaining(); ++i) state.cards[next++] = static_cast<StateHandle>(deck.at(i));
+  for (CardHandle card: hand) state.cards[next++] = static_cast<StateHandle>(card);
+  for (CardHandle card: graveyard) state.cards[next++] = static_cast<StateHandle>(card);
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Restores the player from a snapshot, reusing the storage of the card lists.
+///
+/// @param state Snapshot written by saveState
+///
+//---------------------------------------------------------------------------------------------------------------------
+void Player::loadState(const PlayerState &state)
+{
+  health = state.health;
+  mana = state.mana;
+  manaPoolSize = state.manaPoolSize;
+  redrawEnabled = state.redrawEnabled;
+
+  const StateHandle *cards = state.cards.data();
+  deck.clear(state.deckSequence);
+  for (size_t i = 0; i < state.deckCount; ++i) deck.pushBottom(*cards++);
+  hand.assign(cards, cards + state.handCount);
+  cards += state.handCount;
+  graveyard.assign(cards, cards + state.graveyardCount);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Deals the deck (and the hand) anew from one shuffled pile. The deck keeps its sequence numbers.
+///
+/// @param withHand Shuffle the hand into the deck before dealing
+/// @param seed     Seed of the shuffle
+///
+//---------------------------------------------------------------------------------------------------------------------
+void Player::redealHidden(bool withHand, uint64_t seed)
+{
+  vector<CardHandle> pile;
+  pile.reserve(deck.remaining() + hand.size());
+  for (size_t i = 0; i < deck.remaining(); ++i) pile.push_back(deck.at(i));
+  if (withHand) pile.insert(pile.end(), hand.begin(), hand.end());
+
+  mt19937_64 rng(seed);
+  shuffle(pile.begin(), pile.end(), rng);
+
+  size_t dealt = 0;
+  if (withHand)
+  {
+    copy(pile.begin(), pile.begin() + static_cast<ptrdiff_t>(hand.size()), hand.begin());
+    dealt = hand.size();
+  }
+  deck.clear(deck.getFirstSequence());
+  for (size_t i = dealt; i < pile.size(); ++i) deck.pushBottom(pile[i]);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Toggles every fact about the player in a hash.
+///
+/// @param target Hash to update
+///
+//---------------------------------------------------------------------------------------------------------------------
+void Player::hashState(StateHash &target) const
+{
+  target.toggle(HashFeature::PlayerHealth, id, static_cast<uint32_t>(health));
+  target.toggle(HashFeature::PlayerMana, id, static_cast<uint32_t>(mana));
+  target.toggle(HashFeature::PlayerManaPool, id, static_cast<uint32_t>(manaPoolSize));
+  if (redrawEnabled) target.toggle(HashFeature::PlayerRedraw, id, 0);
+  deck.hashCards(target);
+  for (CardHandle card: hand) target.toggle(HashFeature::CardInHand, card, id);
+  for (CardHandle card: graveyard) target.toggle(HashFeature::CardInGraveyard, card, id);
 }
@@ -10,12 +10,11 @@
 #pragma once
 
 #include <vector>
-#include <memory>
 #include <string>
-
-class Card;
-class CreatureCard;
-class Deck;
+#include <iosfwd>
+#include "CardPool.hpp"
+#include "Deck.hpp"
+#include "GameState.hpp"
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
@@ -36,6 +35,51 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   Player(int playerId, int startHealth, int manaPoolStart);
 
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Sets the pool the deck, hand and graveyard handles refer to.
+  ///
+  /// @param cards Card pool of the owning game
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void bindCardPool(CardPool &cards) { pool = &cards; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Sets the journal that records the changes to this player and their deck.
+  ///
+  /// @param undo Journal of the owning game (nullptr for none)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void bindUndoJournal(UndoJournal *undo)
+  {
+    journal = undo;
+    deck.bindUndoJournal(undo);
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Sets the state hash that tracks this player's stats and cards (deck included).
+  ///
+  /// @param stateHash Hash of the owning game (nullptr for none)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void bindStateHash(StateHash *stateHash)
+  {
+    hash = stateHash;
+    deck.bindStateHash(stateHash, id);
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Toggles all facts about this player (stats, deck, hand, graveyard) in a hash, e.g. to build
+  /// one from scratch.
+  ///
+  /// @param target Hash to update
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void hashState(StateHash &target) const;
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Draws a single card from the deck to the hand.
@@ -70,22 +114,22 @@ public:
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
-  /// Searches for a card in hand by its ID (case-insensitive).
+  /// Searches for a card in hand by its interned kind.
   ///
-  /// @param id The card ID to search for
+  /// @param kind The card kind to search for (see CardFactory::findKind)
   /// @return Pointer to the card if found, otherwise nullptr
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  Card *findCardInHandById(const std::string &id);
+  Card *findCardInHand(CardKind kind);
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
-  /// Assigns a deck to the player by copying card pointers.
+  /// Returns the player's draw pile, e.g. to load it from the GAME config.
   ///
-  /// @param d Reference to the deck to assign
+  /// @return Reference to the player's deck
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  void setDeck(Deck &d);
+  Deck &getDeck() { return deck; }
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -122,35 +166,37 @@ public:
   ///
   /// Adds a defeated creature to the graveyard.
   ///
-  /// @param creature Shared pointer to the defeated creature card
+  /// @param creature Handle of the defeated creature card
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  void addToGraveyard(std::shared_ptr<CreatureCard> creature);
+  void addToGraveyard(CardHandle creature);
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Adds a card to the player's hand.
   ///
-  /// @param card Shared pointer to the card
+  /// @param card Handle of the card
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  void addCardToHand(std::shared_ptr<Card> card);
+  void addCardToHand(CardHandle card);
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
-  /// Returns a modifiable reference to the graveyard.
+  /// Removes the most recent occurrence of a card from the graveyard.
   ///
-  /// @return Reference to vector of creature cards in graveyard
+  /// @param card Handle of the card to remove
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  std::vector<std::shared_ptr<CreatureCard> > &getMutableGraveyard();
+  void removeLastFromGraveyard(CardHandle card);
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Prints the player's current hand in formatted ASCII form.
   ///
+  /// @param os Stream the hand is written to
+  ///
   //---------------------------------------------------------------------------------------------------------------------
-  void printHand() const;
+  void printHand(std::ostream &os) const;
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -201,19 +247,19 @@ public:
   ///
   /// Returns a const reference to the hand.
   ///
-  /// @return Vector of shared pointers to cards in hand
+  /// @return Vector of handles of the cards in hand
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  const std::vector<std::shared_ptr<Card> > &getHand() const;
+  const std::vector<CardHandle> &getHand() const;
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Returns a const reference to the graveyard.
   ///
-  /// @return Vector of shared pointers to creature cards in graveyard
+  /// @return Vector of handles of the creature cards in graveyard
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  const std::vector<std::shared_ptr<CreatureCard> > &getGraveyard() const;
+  const std::vector<CardHandle> &getGraveyard() const;
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -246,12 +292,45 @@ public:
   ///
   /// Removes a creature card from the graveyard by ID match.
   ///
-  /// @param card Card to remove
+  /// @param card Handle of the card to remove
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void removeFromGraveyard(CardHandle card);
+
+  CardHandle extractCardFromHand(Card *rawPtr);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Writes health, mana, the redraw flag and the deck, hand and graveyard into a snapshot.
+  ///
+  /// @param state Snapshot of this player
+  ///
+  /// @return false if the cards do not fit the snapshot
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  void removeFromGraveyard(std::shared_ptr<CreatureCard> card);
+  bool saveState(PlayerState &state) const;
 
-  std::shared_ptr<Card> extractCardFromHand(Card *rawPtr);
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Replaces health, mana, the redraw flag and all card lists with those of a snapshot. Not
+  /// recorded by the undo journal.
+  ///
+  /// @param state Snapshot written by saveState
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void loadState(const PlayerState &state);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Shuffles the cards an opponent cannot see: the deck and, if asked, the hand. Both are dealt
+  /// from one shuffled pile, so the hand keeps its size. Neither the undo journal nor the state hash
+  /// is updated; the caller rebuilds the hash.
+  ///
+  /// @param withHand Shuffle the hand into the deck before dealing
+  /// @param seed     Seed of the shuffle
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void redealHidden(bool withHand, uint64_t seed);
 
 private:
   int id;
@@ -260,7 +339,10 @@ private:
   int manaPoolSize;
   bool redrawEnabled;
 
-  std::vector<std::shared_ptr<Card> > deck;
-  std::vector<std::shared_ptr<Card> > hand; // Cards in hand
-  std::vector<std::shared_ptr<CreatureCard> > graveyard; // Destroyed creatures
+  Deck deck; // Draw pile
+  std::vector<CardHandle> hand; // Cards in hand
+  std::vector<CardHandle> graveyard; // Destroyed creatures
+  CardPool *pool = nullptr; // Pool the handles refer to
+  UndoJournal *journal = nullptr; // Records changes while an action can be undone
+  StateHash *hash = nullptr; // Hash of the owning game
 };
@@ -0,0 +1,44 @@
+// --------------------------- RoundSchedule.hpp ---------------------------
+//
+// Declares the closed-form attacker schedule shared by the game flow and
+// the board printer. The attacker alternates every two rounds starting
+// with Player 1: rounds 1, 4, 5, 8, 9, ... belong to Player 1 and rounds
+// 2, 3, 6, 7, ... to Player 2, for any round number.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns whether Player 1 attacks (and is printed at the bottom of the board) in a round.
+///
+/// @param roundNumber 1-based round number
+///
+/// @return true for rounds congruent to 0 or 1 modulo 4
+///
+//---------------------------------------------------------------------------------------------------------------------
+constexpr bool isPlayer1AttackerRound(int roundNumber)
+{
+  return (roundNumber & 3) <= 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Returns the id of the attacking player in a round.
+///
+/// @param roundNumber 1-based round number
+///
+/// @return 1 or 2
+///
+//---------------------------------------------------------------------------------------------------------------------
+constexpr int attackerIdForRound(int roundNumber)
+{
+  return isPlayer1AttackerRound(roundNumber) ? 1 : 2;
+}
+
+static_assert(isPlayer1AttackerRound(1) && !isPlayer1AttackerRound(2) && !isPlayer1AttackerRound(3) &&
+              isPlayer1AttackerRound(4) && isPlayer1AttackerRound(24) && !isPlayer1AttackerRound(26) &&
+              isPlayer1AttackerRound(1000001), "attacker schedule must match rounds 1, 4, 5, 8, ...");
@@ -0,0 +1,115 @@
+// --------------------------- Simulation.cpp ---------------------------
+//
+// Implements the HeadlessSimulator batch runner and its report.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "Simulation.hpp"
+#include "CommandSource.hpp"
+#include "Game.hpp"
+#include <chrono>
+#include <ostream>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Prints the report: game count and the result distribution, and the throughput on its own
+/// stream.
+///
+/// @param os     Stream for the game count and the results
+/// @param timing Stream for the timing line
+///
+//---------------------------------------------------------------------------------------------------------------------
+void SimulationReport::print(ostream &os, ostream &timing) const
+{
+  os << "Simulated " << games << " game(s)\n"
+      << "Player 1 wins: " << p1Wins << "\n"
+      << "Player 2 wins: " << p2Wins << "\n"
+      << "Ties: " << ties << "\n"
+      << "Unfinished: " << unfinished << "\n";
+  os.flush();
+  timing << "Time: " << seconds << " s (" << gamesPerSecond() << " games/s)\n";
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Counts one finished game under its result.
+///
+/// @param result Result returned by Game::simulate
+///
+//---------------------------------------------------------------------------------------------------------------------
+void SimulationReport::record(GameResult result)
+{
+  switch (result)
+  {
+    case GameResult::P1_Wins: p1Wins++;
+      break;
+    case GameResult::P2_Wins: p2Wins++;
+      break;
+    case GameResult::Tie: ties++;
+      break;
+    default: unfinished++;
+      break;
+  }
+  games++;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Adds the game counts of another report.
+///
+/// @param other Report to merge in
+///
+//---------------------------------------------------------------------------------------------------------------------
+void SimulationReport::merge(const SimulationReport &other)
+{
+  games += other.games;
+  p1Wins += other.p1Wins;
+  p2Wins += other.p2Wins;
+  ties += other.ties;
+  unfinished += other.unfinished;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Parses both config files and the card data once for all games of the batch.
+///
+/// @param gameConfigPath Path to the GAME config file
+/// @param messageConfigPath Path to the MESSAGE config file
+///
+//---------------------------------------------------------------------------------------------------------------------
+HeadlessSimulator::HeadlessSimulator(const string &gameConfigPath, const string &messageConfigPath)
+  : config(gameConfigPath)
+    , messages(messageConfigPath)
+    , catalog(CardCatalog::load())
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Plays the batch and tallies the results.
+///
+/// @param games  Number of games to play
+/// @param source Supplier of the command lines, reset before each game
+///
+/// @return Results and timing of the batch
+///
+//---------------------------------------------------------------------------------------------------------------------
+SimulationReport HeadlessSimulator::run(size_t games, CommandSource &source) const
+{
+  SimulationReport report;
+  auto start = chrono::steady_clock::now();
+
+  for (size_t i = 0; i < games; ++i)
+  {
+    source.reset();
+    Game game(config, messages, catalog);
+    report.record(game.simulate(source));
+  }
+
+  report.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  return report;
+}
@@ -0,0 +1,107 @@
+// --------------------------- Simulation.hpp ---------------------------
+//
+// Declares the HeadlessSimulator, which plays many complete games
+// in-process without terminal I/O and reports throughput and results.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include "ConfigParser.hpp"
+#include "MessageConfigParser.hpp"
+#include "Game.hpp"
+
+class CommandSource;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Aggregated outcome of a batch of simulated games.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct SimulationReport
+{
+  size_t games = 0; ///< number of games played
+  size_t p1Wins = 0; ///< games won by player 1
+  size_t p2Wins = 0; ///< games won by player 2
+  size_t ties = 0; ///< games ending in a tie
+  size_t unfinished = 0; ///< games quit or abandoned by the command source
+  double seconds = 0.0; ///< wall-clock time spent playing
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Throughput of the batch in games per second (0 if no time was measured)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  double gamesPerSecond() const { return seconds > 0.0 ? static_cast<double>(games) / seconds : 0.0; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Counts one finished game.
+  ///
+  /// @param result Result returned by Game::simulate
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void record(GameResult result);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Adds the game counts of another report (timing is left untouched).
+  ///
+  /// @param other Report to merge in
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void merge(const SimulationReport &other);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Prints the report in a short human-readable form. The game counts are deterministic for a
+  /// deterministic command source; the timing goes to its own stream.
+  ///
+  /// @param os     Stream for the game count and the results
+  /// @param timing Stream for the timing line
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void print(std::ostream &os, std::ostream &timing) const;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Plays complete games headless (see Game::simulate). The config files are parsed once and every
+/// game starts from the same configuration.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class HeadlessSimulator
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param gameConfigPath Path to the GAME config file
+  /// @param messageConfigPath Path to the MESSAGE config file
+  ///
+  /// @throws std::runtime_error if a config file cannot be parsed
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  HeadlessSimulator(const std::string &gameConfigPath, const std::string &messageConfigPath);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Plays the given number of games, each driven by the command source (reset before every game).
+  ///
+  /// @param games  Number of games to play
+  /// @param source Supplier of the command lines
+  ///
+  /// @return Results and timing of the batch
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  SimulationReport run(size_t games, CommandSource &source) const;
+
+private:
+  GameConfigParser config;
+  MessageConfigParser messages;
+  std::shared_ptr<const CardCatalog> catalog;
+};
@@ -15,22 +15,6 @@
 
 using namespace std; // bring in std symbols for clarity
 
-//---------------------------------------------------------------------------------------------------------------------
-///
-/// Enum class representing different types of spell behaviors.
-///
-/// - General   → one-time effect, no specific target
-/// - Target    → directed at a specific card or player
-/// - Graveyard → interacts with graveyard cards
-///
-//---------------------------------------------------------------------------------------------------------------------
-enum class SpellType
-{
-  General, ///< one-time effect without specific target
-  Target, ///< effect directed at a specific card or player
-  Graveyard ///< effect interacts with cards in the graveyard
-};
-
 //---------------------------------------------------------------------------------------------------------------------
 ///
 /// Concrete card type representing spell cards. Inherits from Card.
@@ -41,26 +25,17 @@ enum class SpellType
 //---------------------------------------------------------------------------------------------------------------------
 class SpellCard : public Card
 {
-protected:
-  SpellType spellType; ///< specific type of this spell
-
 public:
   //---------------------------------------------------------------------------------------------------------------------
   ///
-  /// Constructs a new SpellCard with given ID, name, mana cost, and spell type.
+  /// Constructs a new SpellCard. ID, name, mana cost (-1 if variable/X-cost), spell type and
+  /// effect are read from the shared definition.
   ///
-  /// @param id         Unique card ID (uppercase, 5 characters)
-  /// @param name       Display name of the spell
-  /// @param manaCost   Mana required to cast the spell (-1 if variable/X-cost)
-  /// @param spellType  Category of the spell (General, Target, or Graveyard)
+  /// @param definition  Spell definition from the CardCatalog
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  SpellCard(const string &id,
-            const string &name,
-            int manaCost,
-            SpellType spellType)
-    : Card(id, name, manaCost, CardType::Spell)
-      , spellType(spellType)
+  explicit SpellCard(const CardDefinition &definition)
+    : Card(definition)
   {
   }
 
@@ -71,7 +46,16 @@ public:
   /// @return SpellType enum (General, Target, or Graveyard)
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  SpellType getSpellType() const { return spellType; }
+  SpellType getSpellType() const { return definition->spellType; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Returns the effect this spell resolves to.
+  ///
+  /// @return SpellEffect enum
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  SpellEffect getEffect() const { return definition->effect; }
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -88,10 +72,13 @@ public:
   /// Prints an ASCII-art representation of the spell card.
   /// Includes formatted mana cost and leaves trait zone empty.
   ///
+  /// @param os Stream the card is written to
+  ///
   //---------------------------------------------------------------------------------------------------------------------
-  void printCardDetails() const override
+  void printCardDetails(ostream &os) const override
   {
     // Format mana cost (XX for variable)
+    int manaCost = definition->manaCost;
     string manaStr = (manaCost == -1) ? "XX" : to_string(manaCost);
     while (manaStr.length() < 2)
     {
@@ -99,13 +86,13 @@ public:
     }
 
     // ID assumed uppercase and length 5
-    string cardID = id;
+    const string &cardID = definition->id;
 
     // Print ASCII layout
-    cout << " _____M" << manaStr << endl;
-    cout << "| " << cardID << " |" << endl;
-    cout << "|       |" << endl;
-    cout << " _______" << endl;
+    os << " _____M" << manaStr << "\n";
+    os << "| " << cardID << " |" << "\n";
+    os << "|       |" << "\n";
+    os << " _______" << "\n";
   }
 };
 
@@ -0,0 +1,125 @@
+// --------------------------- StateHash.hpp ---------------------------
+//
+// Declares StateHash, the incrementally maintained Zobrist hash of a
+// game's cards, players and board.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Kinds of facts that make up the hashed state. Each fact (e.g. "card 12 is in hand of player 1",
+/// "card 12 has 3 HP") has its own 64-bit key, and the hash is the XOR of the keys of all facts
+/// that currently hold.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class HashFeature : uint8_t
+{
+  CardInDeck, ///< card, owner and absolute deck sequence number
+  CardInHand, ///< card and owner
+  CardInGraveyard, ///< card and owner
+  CardInZone, ///< card and board slot
+  Kind, ///< card and its definition, so reused handles of different cards differ
+  Attack, ///< creature and current attack
+  Health, ///< creature and current health
+  SummonedRound, ///< creature and round it was summoned in
+  Traits, ///< creature and trait bits
+  LastField, ///< creature, last field slot and owner
+  Resurrected, ///< creature resurrected by Undying
+  PlayerHealth, ///< player and health
+  PlayerMana, ///< player and mana
+  PlayerManaPool, ///< player and mana pool size
+  PlayerRedraw, ///< player may still redraw
+  Round, ///< round number
+  Turn ///< current player, attacker, done counter, phase, result
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Zobrist hash with keys derived from the fact itself instead of a random table, so cards created
+/// during the game (clones, revived creatures) need no table space. Keys are a fixed function of
+/// the fact, so equal states hash equally in every process.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class StateHash
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Returns the key of a fact.
+  ///
+  /// @param feature Kind of fact
+  /// @param subject Card handle or player id the fact is about
+  /// @param value   Value of the fact (slot, HP, owner, ...); only the low 40 bits count
+  ///
+  /// @return 64-bit key
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static constexpr uint64_t key(HashFeature feature, uint32_t subject, uint64_t value)
+  {
+    // splitmix64 finalizer over the packed fact; subjects beyond 16 bits are spread over the word
+    uint64_t x = (static_cast<uint64_t>(feature) << 56) ^ (static_cast<uint64_t>(subject & 0xFFFF) << 40) ^
+                 (value & 0xFFFFFFFFFFull) ^ (static_cast<uint64_t>(subject >> 16) * 0xD6E8FEB86659FD93ull);
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Adds a fact that starts to hold or removes one that stops holding (XOR is its own inverse).
+  ///
+  /// @param feature Kind of fact
+  /// @param subject Card handle or player id
+  /// @param value   Value of the fact
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void toggle(HashFeature feature, uint32_t subject, uint64_t value) { hash ^= key(feature, subject, value); }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Replaces the value of a fact.
+  ///
+  /// @param feature  Kind of fact
+  /// @param subject  Card handle or player id
+  /// @param oldValue Value that stops holding
+  /// @param newValue Value that holds from now on
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void change(HashFeature feature, uint32_t subject, uint64_t oldValue, uint64_t newValue)
+  {
+    hash ^= key(feature, subject, oldValue) ^ key(feature, subject, newValue);
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return The current hash
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  uint64_t value() const { return hash; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Overwrites the hash, e.g. with one computed from scratch.
+  ///
+  /// @param newHash New hash value
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void reset(uint64_t newHash) { hash = newHash; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Reference to the raw value, so the undo journal can save and restore it
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  uint64_t &raw() { return hash; }
+
+private:
+  uint64_t hash = 0;
+};
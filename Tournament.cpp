@@ -0,0 +1,151 @@
+// --------------------------- Tournament.cpp ---------------------------
+//
+// Implements the parallel Tournament runner: matchup loading, scheduling
+// the games on worker threads and merging the results.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "Tournament.hpp"
+#include "CommandSource.hpp"
+#include "WorkStealingScheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Parses both config files and the card data once for the whole tournament.
+///
+/// @param gameConfigPath GAME config providing the game constants
+/// @param messageConfigPath Path to the MESSAGE config file
+///
+//---------------------------------------------------------------------------------------------------------------------
+Tournament::Tournament(const string &gameConfigPath, const string &messageConfigPath)
+  : config(gameConfigPath)
+    , messages(messageConfigPath)
+    , catalog(CardCatalog::load())
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Reads deck lines pairwise: line 1 is Player 1's deck, line 2 Player 2's deck, and so on.
+///
+/// @param path Path to the deck pair file
+///
+/// @return Matchups in file order
+///
+//---------------------------------------------------------------------------------------------------------------------
+vector<Matchup> Tournament::loadMatchups(const string &path)
+{
+  ifstream in(path);
+  if (!in.is_open())
+  {
+    throw runtime_error("Could not open deck pair file: " + path);
+  }
+
+  vector<vector<string> > decks;
+  string line;
+  while (getline(in, line))
+  {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.empty() || line[0] == '#') continue;
+    decks.push_back(GameConfigParser::splitIds(line));
+  }
+  if (decks.size() % 2 != 0)
+  {
+    throw runtime_error("Deck pair file has an unpaired deck line: " + path);
+  }
+
+  vector<Matchup> matchups;
+  for (size_t i = 0; i < decks.size(); i += 2)
+  {
+    matchups.push_back({decks[i], decks[i + 1]});
+  }
+  return matchups;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Runs the games in groups of lockstepGames consecutive games (which may span matchups), each group
+/// an independent task. Each task writes only the result slots of its games and each worker keeps
+/// its own config copy, command sources and LockstepSimulator, so there is no shared mutable state
+/// while playing; the results are folded into the per-matchup reports after all workers have joined.
+///
+/// @param matchups        Deck pairings to play
+/// @param gamesPerMatchup Games per pairing
+/// @param threads         Worker threads (0 = hardware concurrency)
+/// @param makeSource      Creates the command sources of each worker
+/// @param lockstepGames   Games per group
+///
+/// @return Per-matchup and merged results
+///
+//---------------------------------------------------------------------------------------------------------------------
+TournamentReport Tournament::run(const vector<Matchup> &matchups, size_t gamesPerMatchup, unsigned threads,
+                                 const SourceFactory &makeSource, size_t lockstepGames) const
+{
+  if (lockstepGames == 0)
+  {
+    throw runtime_error("A lockstep group needs at least one game");
+  }
+  WorkStealingScheduler scheduler(threads);
+  vector<vector<unique_ptr<CommandSource> > > sources(scheduler.getThreadCount());
+  vector<GameConfigParser> configs(scheduler.getThreadCount(), config);
+  vector<LockstepSimulator> simulators(scheduler.getThreadCount());
+  for (vector<unique_ptr<CommandSource> > &workerSources: sources)
+  {
+    for (size_t g = 0; g < lockstepGames; ++g)
+    {
+      workerSources.push_back(makeSource());
+    }
+  }
+
+  size_t gameCount = matchups.size() * gamesPerMatchup;
+  size_t groupCount = (gameCount + lockstepGames - 1) / lockstepGames;
+  vector<GameResult> results(gameCount, GameResult::None);
+
+  auto start = chrono::steady_clock::now();
+  scheduler.run(groupCount, [&](size_t group, unsigned worker)
+  {
+    size_t first = group * lockstepGames;
+    size_t count = min(lockstepGames, gameCount - first);
+    GameConfigParser &workerConfig = configs[worker];
+    LockstepSimulator &simulator = simulators[worker];
+
+    // A deque keeps the games in place while more are added
+    deque<Game> games;
+    for (size_t g = 0; g < count; ++g)
+    {
+      const Matchup &matchup = matchups[(first + g) / gamesPerMatchup];
+      workerConfig.setDecks(matchup.deck1, matchup.deck2);
+      CommandSource &source = *sources[worker][g];
+      source.reset();
+      games.emplace_back(workerConfig, messages, catalog);
+      simulator.add(games.back(), source);
+    }
+    simulator.play();
+    for (size_t g = 0; g < count; ++g)
+    {
+      results[first + g] = games[g].getResult();
+    }
+  });
+
+  TournamentReport report;
+  report.matchups.resize(matchups.size());
+  for (size_t i = 0; i < gameCount; ++i)
+  {
+    report.matchups[i / gamesPerMatchup].record(results[i]);
+  }
+  for (const SimulationReport &matchup: report.matchups)
+  {
+    report.total.merge(matchup);
+  }
+  report.total.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  return report;
+}
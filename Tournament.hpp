@@ -0,0 +1,105 @@
+// --------------------------- Tournament.hpp ---------------------------
+//
+// Declares the Tournament, which plays a list of deck matchups headless
+// on all cores using the WorkStealingScheduler and merges the results.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "LockstepSimulator.hpp"
+#include "Simulation.hpp"
+
+class CommandSource;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// One pairing of decks: Player 1 plays deck1, Player 2 plays deck2.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct Matchup
+{
+  std::vector<std::string> deck1; ///< card IDs of Player 1's deck
+  std::vector<std::string> deck2; ///< card IDs of Player 2's deck
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Results of a tournament: one report per matchup plus the merged total (which carries the timing).
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct TournamentReport
+{
+  std::vector<SimulationReport> matchups;
+  SimulationReport total;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Plays deck matchups in parallel. Games are played in groups by a LockstepSimulator per worker,
+/// each group an independent task; games share only the read-only parsed configs, so the run
+/// scales with the number of cores.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class Tournament
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Creates a fresh command source for one game of a lockstep group.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  using SourceFactory = std::function<std::unique_ptr<CommandSource>()>;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param gameConfigPath GAME config providing the constants (health, rounds, mana) for all games
+  /// @param messageConfigPath Path to the MESSAGE config file
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  Tournament(const std::string &gameConfigPath, const std::string &messageConfigPath);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Loads matchups from a file holding pairs of deck lines in the GAME config deck format
+  /// (";"-separated card IDs). Empty lines and '#' comments are skipped.
+  ///
+  /// @param path Path to the deck pair file
+  ///
+  /// @return Matchups in file order
+  ///
+  /// @throws std::runtime_error if the file cannot be opened or holds an odd number of deck lines
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  static std::vector<Matchup> loadMatchups(const std::string &path);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Plays every matchup gamesPerMatchup times on the given number of threads.
+  ///
+  /// @param matchups        Deck pairings to play
+  /// @param gamesPerMatchup Games per pairing
+  /// @param threads         Worker threads (0 = hardware concurrency)
+  /// @param makeSource      Creates the command sources, one per game of a group and worker
+  /// @param lockstepGames   Games played side by side per group (1 = one game at a time)
+  ///
+  /// @return Per-matchup and merged results
+  ///
+  /// @throws std::runtime_error if lockstepGames is 0
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  TournamentReport run(const std::vector<Matchup> &matchups, size_t gamesPerMatchup, unsigned threads,
+                       const SourceFactory &makeSource,
+                       size_t lockstepGames = LockstepSimulator::DEFAULT_GAMES) const;
+
+private:
+  GameConfigParser config;
+  MessageConfigParser messages;
+  std::shared_ptr<const CardCatalog> catalog;
+};
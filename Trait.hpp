@@ -0,0 +1,145 @@
+// --------------------------- Trait.hpp ---------------------------
+//
+// This file defines the Trait enum of creature abilities, the TraitSet
+// bitmask holding the traits of a creature, and the name and board
+// code helpers for printing them.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+//-----------------------------------------------------------------------------
+// Trait: flags indicating special abilities or statuses for creature cards.
+// The enumerators are kept in alphabetical order of their names, so the bit
+// order of a TraitSet is also the display and "first alphabetically" order.
+//-----------------------------------------------------------------------------
+enum class Trait : uint8_t
+{
+  Brutal, ///< deals extra damage
+  Challenger, ///< forces blocks
+  FirstStrike, ///< attacks before defenders
+  Haste, ///< can attack immediately
+  Lifesteal, ///< heals controller on damage
+  Poisoned, ///< applies poison effect
+  Regenerate, ///< recovers health after destruction
+  Temporary, ///< limited-duration buffs
+  Undying, ///< returns with 1 HP when destroyed
+  Venomous ///< applies poison on attack
+};
+
+constexpr size_t TRAIT_COUNT = 10;
+
+// Full trait names and single-letter board codes, indexed by Trait
+constexpr std::array<std::string_view, TRAIT_COUNT> TRAIT_NAMES = {
+  "Brutal", "Challenger", "First Strike", "Haste", "Lifesteal",
+  "Poisoned", "Regenerate", "Temporary", "Undying", "Venomous"
+};
+constexpr std::array<char, TRAIT_COUNT> TRAIT_LETTERS = {'B', 'C', 'F', 'H', 'L', 'P', 'R', 'T', 'U', 'V'};
+
+static_assert(std::is_sorted(TRAIT_NAMES.begin(), TRAIT_NAMES.end()), "Trait enum must stay alphabetical");
+static_assert(std::is_sorted(TRAIT_LETTERS.begin(), TRAIT_LETTERS.end()), "Trait letters must stay alphabetical");
+
+// -------------------------------------------------------------
+// TraitSet: fixed-size bitmask of traits (bit i = Trait i).
+// Copying is a plain 16-bit copy and every query is a single
+// bit operation; iteration yields the traits alphabetically.
+// -------------------------------------------------------------
+class TraitSet
+{
+private:
+  uint16_t bits = 0;
+
+  static constexpr uint16_t bit(Trait t) { return static_cast<uint16_t>(1u << static_cast<unsigned>(t)); }
+
+public:
+  constexpr TraitSet() = default;
+
+  constexpr explicit TraitSet(uint16_t bits) : bits(bits) {}
+
+  constexpr bool has(Trait t) const { return (bits & bit(t)) != 0; }
+
+  constexpr void add(Trait t) { bits |= bit(t); }
+
+  constexpr void remove(Trait t) { bits &= static_cast<uint16_t>(~bit(t)); }
+
+  // Removes the alphabetically first trait (the lowest set bit)
+  constexpr void removeFirst() { bits &= static_cast<uint16_t>(bits - 1); }
+
+  constexpr bool empty() const { return bits == 0; }
+
+  constexpr int size() const { return std::popcount(bits); }
+
+  constexpr uint16_t getBits() const { return bits; }
+
+  constexpr bool operator==(const TraitSet &other) const = default;
+
+  // Walks the set bits from lowest to highest
+  class const_iterator
+  {
+  private:
+    uint16_t rest;
+
+  public:
+    constexpr explicit const_iterator(uint16_t rest) : rest(rest) {}
+
+    constexpr Trait operator*() const { return static_cast<Trait>(std::countr_zero(rest)); }
+
+    constexpr const_iterator &operator++()
+    {
+      rest &= static_cast<uint16_t>(rest - 1);
+      return *this;
+    }
+
+    constexpr bool operator!=(const const_iterator &other) const { return rest != other.rest; }
+  };
+
+  constexpr const_iterator begin() const { return const_iterator(bits); }
+
+  constexpr const_iterator end() const { return const_iterator(0); }
+};
+
+// -------------------------------------------------------------
+// Board trait codes for every possible TraitSet: the sorted
+// trait letters, at most 5 and with '+' as 5th letter when
+// more traits are present. Built once at compile time.
+// -------------------------------------------------------------
+using TraitCode = std::array<char, 6>;
+
+constexpr std::array<TraitCode, (1u << TRAIT_COUNT)> TRAIT_CODES = []()
+{
+  std::array<TraitCode, (1u << TRAIT_COUNT)> codes{};
+  for (unsigned mask = 0; mask < codes.size(); ++mask)
+  {
+    size_t length = 0;
+    for (Trait t: TraitSet(static_cast<uint16_t>(mask)))
+    {
+      if (length < 5) codes[mask][length++] = TRAIT_LETTERS[static_cast<size_t>(t)];
+    }
+    if (std::popcount(mask) > 5) codes[mask][4] = '+';
+  }
+  return codes;
+}();
+
+// Returns the (unpadded) board trait code of a set
+inline std::string_view traitCode(TraitSet traits)
+{
+  return std::string_view(TRAIT_CODES[traits.getBits()].data());
+}
+
+// -------------------------------------------------------------
+// Converts a Trait enum value into a full string name.
+// -------------------------------------------------------------
+inline std::string traitToString(Trait t)
+{
+  size_t index = static_cast<size_t>(t);
+  return index < TRAIT_COUNT ? std::string(TRAIT_NAMES[index]) : "";
+}
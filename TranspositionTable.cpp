@@ -0,0 +1,202 @@
+// --------------------------- TranspositionTable.cpp ---------------------------
+//
+// Implements the lock-free TranspositionTable.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "TranspositionTable.hpp"
+#include <algorithm>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Creates the table.
+///
+/// @param megabytes Memory to use
+/// @param policy    Replacement policy for full buckets
+//---------------------------------------------------------------------------------------------------------------------
+TranspositionTable::TranspositionTable(size_t megabytes, TTReplacement policy) : policy(policy)
+{
+  resize(megabytes);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Allocates the largest power of two number of buckets that fits the given memory.
+///
+/// @param megabytes Memory to use
+//---------------------------------------------------------------------------------------------------------------------
+void TranspositionTable::resize(size_t megabytes)
+{
+  size_t wanted = max<size_t>(1, megabytes * 1024 * 1024 / sizeof(Bucket));
+  size_t count = 1;
+  while (count * 2 <= wanted) count *= 2;
+
+  buckets = make_unique<Bucket[]>(count);
+  bucketMask = count - 1;
+  generation = 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Empties every entry.
+//---------------------------------------------------------------------------------------------------------------------
+void TranspositionTable::clear()
+{
+  for (size_t i = 0; i <= bucketMask; ++i)
+  {
+    for (Entry &entry: buckets[i].entries)
+    {
+      entry.key.store(0, memory_order_relaxed);
+      entry.data.store(0, memory_order_relaxed);
+    }
+  }
+  generation = 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Packs a result into one word: value in bits 0-31, move in 32-47, depth in 48-55, bound in 56-57
+/// and the age in 58-63. A stored word is never 0, because the bound of a result is not None.
+///
+/// @param data Result
+/// @param age  Generation of the search that stores it
+///
+/// @return The packed word
+//---------------------------------------------------------------------------------------------------------------------
+uint64_t TranspositionTable::pack(const TTData &data, uint8_t age)
+{
+  return static_cast<uint64_t>(static_cast<uint32_t>(data.value)) |
+         (static_cast<uint64_t>(data.move) << 32) |
+         (static_cast<uint64_t>(data.depth) << 48) |
+         (static_cast<uint64_t>(data.bound) << 56) |
+         (static_cast<uint64_t>(age) << 58);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Unpacks a word written by pack(). The age is dropped.
+///
+/// @param word Packed result
+///
+/// @return The result
+//---------------------------------------------------------------------------------------------------------------------
+TTData TranspositionTable::unpack(uint64_t word)
+{
+  TTData data;
+  data.value = static_cast<int32_t>(static_cast<uint32_t>(word));
+  data.move = static_cast<uint16_t>(word >> 32);
+  data.depth = static_cast<uint8_t>(word >> 48);
+  data.bound = static_cast<TTBound>((word >> 56) & 0x3);
+  return data;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Reads the bucket of the hash and accepts the first entry whose key XOR data is the hash.
+///
+/// @param hash Hash of the position
+/// @param data Receives the result on a hit
+///
+/// @return true on a hit
+//---------------------------------------------------------------------------------------------------------------------
+bool TranspositionTable::probe(uint64_t hash, TTData &data) const
+{
+  const Bucket &bucket = buckets[hash & bucketMask];
+  for (const Entry &entry: bucket.entries)
+  {
+    uint64_t word = entry.data.load(memory_order_relaxed);
+    uint64_t key = entry.key.load(memory_order_relaxed);
+    if ((key ^ word) == hash && word != 0)
+    {
+      data = unpack(word);
+      return true;
+    }
+  }
+  return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Picks the entry a new result for the hash goes to: the entry of the same position, an empty
+/// entry, or the victim chosen by the replacement policy.
+///
+/// @param bucket Bucket of the hash
+/// @param hash   Hash of the position
+///
+/// @return Index of the entry in the bucket
+//---------------------------------------------------------------------------------------------------------------------
+size_t TranspositionTable::chooseVictim(const Bucket &bucket, uint64_t hash) const
+{
+  uint64_t words[BUCKET_ENTRIES];
+  for (size_t i = 0; i < BUCKET_ENTRIES; ++i)
+  {
+    words[i] = bucket.entries[i].data.load(memory_order_relaxed);
+    uint64_t key = bucket.entries[i].key.load(memory_order_relaxed);
+    if (words[i] == 0 || (key ^ words[i]) == hash) return i;
+  }
+
+  if (policy == TTReplacement::Always) return 0;
+
+  size_t victim = 0;
+  int lowest = 0;
+  for (size_t i = 0; i < BUCKET_ENTRIES; ++i)
+  {
+    int score = static_cast<uint8_t>(words[i] >> 48);
+    if (policy == TTReplacement::AgeThenDepth)
+    {
+      // Every search of difference weighs more than any depth
+      int age = (generation - static_cast<uint8_t>(words[i] >> 58)) & GENERATION_MASK;
+      score -= age * 256;
+    }
+    if (i == 0 || score < lowest)
+    {
+      victim = i;
+      lowest = score;
+    }
+  }
+  return victim;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Stores a result. probe() checks both words against each other, so a reader that sees the
+/// words of two racing stores mixed rejects the entry instead of accepting half of each.
+///
+/// @param hash Hash of the position
+/// @param data Result to store
+//---------------------------------------------------------------------------------------------------------------------
+void TranspositionTable::store(uint64_t hash, const TTData &data)
+{
+  if (data.bound == TTBound::None) return;
+  Bucket &bucket = buckets[hash & bucketMask];
+  Entry &entry = bucket.entries[chooseVictim(bucket, hash)];
+
+  uint64_t word = pack(data, generation);
+  entry.data.store(word, memory_order_relaxed);
+  entry.key.store(hash ^ word, memory_order_relaxed);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Estimates how full the table is from the first 250 buckets (or all, if there are fewer).
+///
+/// @return Per mille of entries used by the current search
+//---------------------------------------------------------------------------------------------------------------------
+int TranspositionTable::hashfull() const
+{
+  size_t sampled = min<size_t>(250, bucketMask + 1);
+  size_t used = 0;
+  for (size_t i = 0; i < sampled; ++i)
+  {
+    for (const Entry &entry: buckets[i].entries)
+    {
+      uint64_t word = entry.data.load(memory_order_relaxed);
+      if (word != 0 && static_cast<uint8_t>(word >> 58) == generation) ++used;
+    }
+  }
+  return static_cast<int>(used * 1000 / (sampled * BUCKET_ENTRIES));
+}
@@ -0,0 +1,192 @@
+// --------------------------- TranspositionTable.hpp ---------------------------
+//
+// Declares the TranspositionTable, a fixed-size hash table of search results
+// keyed by Game::stateHash() that several search threads share without
+// locks.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// How a stored value relates to the true value of the position. None marks an empty entry.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class TTBound : uint8_t
+{
+  None,
+  Exact, ///< the value is exact (also used for counts such as perft nodes)
+  Lower, ///< the true value is at least the stored one
+  Upper ///< the true value is at most the stored one
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Which entry of a full bucket a new result replaces.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class TTReplacement : uint8_t
+{
+  Always, ///< always the first entry of the bucket (direct mapped)
+  DepthPreferred, ///< the entry with the shallowest search
+  AgeThenDepth ///< entries of earlier searches first, then the shallowest
+};
+
+constexpr uint16_t TT_NO_MOVE = UINT16_MAX; // move index of results without a best move
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Result stored for a position. It is packed into 64 bits together with the age of the entry.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct TTData
+{
+  int32_t value = 0; ///< score, or count for perft
+  uint16_t move = TT_NO_MOVE; ///< index of the best move in generateMoves order
+  uint8_t depth = 0; ///< remaining depth the value was computed with
+  TTBound bound = TTBound::None;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Shared transposition table. Entries are grouped in buckets of four that fill exactly one cache
+/// line. Every entry is two 64-bit words, the data and the key XOR data, written and read with
+/// relaxed atomics: a reader only accepts an entry if key XOR data gives back the probed hash, so
+/// an entry torn by a concurrent store is simply a miss and no locks are needed. Racing stores may
+/// lose a result, which a search tolerates.
+///
+/// resize(), clear() and newSearch() must not run while other threads use the table.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class TranspositionTable
+{
+public:
+  static constexpr size_t BUCKET_ENTRIES = 4;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param megabytes Memory to use, rounded down to a power of two number of buckets (at least one)
+  /// @param policy    Replacement policy for full buckets
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  explicit TranspositionTable(size_t megabytes = 16, TTReplacement policy = TTReplacement::AgeThenDepth);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Reallocates the table with a new size. All entries are lost.
+  ///
+  /// @param megabytes Memory to use
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void resize(size_t megabytes);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Removes all entries and resets the age.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void clear();
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Starts a new search, so the entries of earlier ones age (see TTReplacement::AgeThenDepth).
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void newSearch() { generation = (generation + 1) & GENERATION_MASK; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Looks up a position. Safe to call concurrently with other probes and stores.
+  ///
+  /// @param hash Game::stateHash() of the position
+  /// @param data Receives the stored result on a hit
+  ///
+  /// @return true on a hit
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool probe(uint64_t hash, TTData &data) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Stores the result for a position, replacing its old result or another entry of the bucket
+  /// chosen by the replacement policy. Safe to call concurrently with other probes and stores.
+  ///
+  /// @param hash Game::stateHash() of the position
+  /// @param data Result to store (bound must not be None)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void store(uint64_t hash, const TTData &data);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Per mille of sampled entries that hold a result of the current search
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  int hashfull() const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Number of entries the table holds
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  size_t capacity() const { return (bucketMask + 1) * BUCKET_ENTRIES; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return The replacement policy
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  TTReplacement getPolicy() const { return policy; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param newPolicy Replacement policy for later stores
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void setPolicy(TTReplacement newPolicy) { policy = newPolicy; }
+
+private:
+  static constexpr uint8_t GENERATION_MASK = 0x3F; // 6 bits next to the bound
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// One entry: the packed TTData and the hash XOR that word.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct Entry
+  {
+    std::atomic<uint64_t> key{0};
+    std::atomic<uint64_t> data{0};
+  };
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Entries sharing a hash index, aligned to one cache line.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct alignas(64) Bucket
+  {
+    Entry entries[BUCKET_ENTRIES];
+  };
+
+  static_assert(sizeof(Bucket) == 64, "a bucket must fill exactly one cache line");
+
+  std::unique_ptr<Bucket[]> buckets;
+  size_t bucketMask = 0;
+  TTReplacement policy;
+  uint8_t generation = 0;
+
+  static uint64_t pack(const TTData &data, uint8_t age);
+
+  static TTData unpack(uint64_t word);
+
+  size_t chooseVictim(const Bucket &bucket, uint64_t hash) const;
+};
@@ -0,0 +1,139 @@
+// --------------------------- UndoJournal.cpp ---------------------------
+//
+// Implements the UndoJournal: opening frames and rolling them back.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "UndoJournal.hpp"
+#include <algorithm>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Opens a frame and starts recording.
+///
+/// @param pool Card pool of the game
+///
+//---------------------------------------------------------------------------------------------------------------------
+void UndoJournal::begin(const CardPool &pool)
+{
+  frames.push_back({entries.size(), pool.size()});
+  nextSerial();
+  recording = true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Reverts the entries of the innermost frame from the newest to the oldest, destroys the cards
+/// created in it and closes it.
+///
+/// @param pool Card pool of the game
+///
+//---------------------------------------------------------------------------------------------------------------------
+void UndoJournal::undo(CardPool &pool)
+{
+  if (frames.empty()) return;
+  Frame frame = frames.back();
+  frames.pop_back();
+  recording = false; // restoring must not record itself
+
+  while (entries.size() > frame.entryCount)
+  {
+    const UndoEntry &entry = entries.back();
+    switch (entry.kind)
+    {
+      case UndoKind::Value:
+        memcpy(entry.target, &entry.value, entry.size);
+        break;
+      case UndoKind::Insert:
+      {
+        auto &cards = *static_cast<vector<CardHandle> *>(entry.target);
+        cards.erase(cards.begin() + entry.index);
+        break;
+      }
+      case UndoKind::Erase:
+      {
+        auto &cards = *static_cast<vector<CardHandle> *>(entry.target);
+        cards.insert(cards.begin() + entry.index, entry.handle);
+        break;
+      }
+      case UndoKind::Creature:
+        *pool.getCreature(entry.handle) = creatures[entry.index];
+        creatures.pop_back();
+        break;
+      case UndoKind::Storage:
+        static_cast<vector<CardHandle> *>(entry.target)->swap(storages[entry.index]);
+        storages.pop_back();
+        break;
+    }
+    entries.pop_back();
+  }
+  pool.truncate(frame.poolSize);
+
+  nextSerial();
+  recording = !frames.empty();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Forgets all frames, e.g. when the game the journal belongs to is overwritten.
+///
+//---------------------------------------------------------------------------------------------------------------------
+void UndoJournal::clear()
+{
+  recording = false;
+  entries.clear();
+  frames.clear();
+  creatures.clear();
+  storages.clear();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Keeps a copy of a handle vector that is about to be replaced.
+///
+/// @param cards Vector about to be replaced
+///
+//---------------------------------------------------------------------------------------------------------------------
+void UndoJournal::saveStorage(vector<CardHandle> &cards)
+{
+  if (!recording) return;
+  entries.push_back({&cards, 0, static_cast<uint32_t>(storages.size()), NO_CARD, UndoKind::Storage, 0});
+  storages.push_back(cards);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Keeps a copy of a creature unless it was already saved in the innermost frame.
+///
+/// @param handle   Handle of the creature
+/// @param creature The creature
+///
+//---------------------------------------------------------------------------------------------------------------------
+void UndoJournal::saveCreature(CardHandle handle, const CreatureCard &creature)
+{
+  if (!recording) return;
+  if (handle >= creatureSerial.size()) creatureSerial.resize(handle + 1, 0);
+  if (creatureSerial[handle] == serial) return;
+  creatureSerial[handle] = serial;
+  entries.push_back({nullptr, 0, static_cast<uint32_t>(creatures.size()), handle, UndoKind::Creature, 0});
+  creatures.push_back(creature);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Gives the innermost frame a new stamp, so creatures saved by a closed frame are saved again
+/// by the frame that continues.
+///
+//---------------------------------------------------------------------------------------------------------------------
+void UndoJournal::nextSerial()
+{
+  if (++serial == 0)
+  {
+    fill(creatureSerial.begin(), creatureSerial.end(), 0);
+    serial = 1;
+  }
+}
@@ -0,0 +1,184 @@
+// --------------------------- UndoJournal.hpp ---------------------------
+//
+// Declares the UndoJournal, which records the old values of the game
+// state changed by an action so the action can be rolled back without
+// copying the game.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "CardPool.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Kind of change an undo entry reverts.
+///
+//---------------------------------------------------------------------------------------------------------------------
+enum class UndoKind : uint8_t
+{
+  Value, ///< a scalar (up to 8 bytes) was overwritten
+  Insert, ///< a handle was inserted into a vector
+  Erase, ///< a handle was erased from a vector
+  Creature, ///< a creature was handed out for modification
+  Storage ///< a handle vector was replaced (deck growth)
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// One recorded change. What target, value and index mean depends on the kind.
+///
+//---------------------------------------------------------------------------------------------------------------------
+struct UndoEntry
+{
+  void *target; ///< changed field or vector (unused for Creature)
+  uint64_t value; ///< old bytes of a Value entry
+  uint32_t index; ///< vector position, or index of the saved creature / storage
+  CardHandle handle; ///< erased handle, or the creature of a Creature entry
+  UndoKind kind;
+  uint8_t size; ///< byte size of a Value entry
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Journal of reversible changes, organised in nested frames (one per action). While a frame is
+/// open, the card holders (players, decks, zones, card pool) record every change they make; undo()
+/// reverts the changes of the innermost frame in reverse order, so rolling back an action costs
+/// O(changes). Outside of frames nothing is recorded.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class UndoJournal
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return true while a frame is open and changes have to be recorded
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  bool isRecording() const { return recording; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Number of open frames
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  size_t depth() const { return frames.size(); }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Opens a frame. Cards created from now on are destroyed again when the frame is undone.
+  ///
+  /// @param pool Card pool of the game
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void begin(const CardPool &pool);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Reverts all changes of the innermost frame and closes it.
+  ///
+  /// @param pool Card pool of the game
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void undo(CardPool &pool);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Drops all frames and entries without reverting anything.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void clear();
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Records the current value of a scalar field before it is overwritten.
+  ///
+  /// @param field Field about to change (int, bool, enum, pointer, handle, ...)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  template<typename T>
+  void save(T &field)
+  {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(uint64_t), "scalar fields only");
+    if (!recording) return;
+    UndoEntry entry{&field, 0, 0, NO_CARD, UndoKind::Value, static_cast<uint8_t>(sizeof(T))};
+    std::memcpy(&entry.value, &field, sizeof(T));
+    entries.push_back(entry);
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Records that a handle was inserted into a vector.
+  ///
+  /// @param cards Vector that grew
+  /// @param index Position of the new handle
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void inserted(std::vector<CardHandle> &cards, size_t index)
+  {
+    if (!recording) return;
+    entries.push_back({&cards, 0, static_cast<uint32_t>(index), NO_CARD, UndoKind::Insert, 0});
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Records that a handle is erased from a vector.
+  ///
+  /// @param cards Vector that shrinks
+  /// @param index Position of the handle
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void erasing(std::vector<CardHandle> &cards, size_t index)
+  {
+    if (!recording) return;
+    entries.push_back({&cards, 0, static_cast<uint32_t>(index), cards[index], UndoKind::Erase, 0});
+  }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Records a whole handle vector before it is replaced. Only used when a deck has to grow.
+  ///
+  /// @param cards Vector about to be replaced
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void saveStorage(std::vector<CardHandle> &cards);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Records the state of a creature that may be modified. Each creature is saved only once per
+  /// frame.
+  ///
+  /// @param handle   Handle of the creature
+  /// @param creature The creature
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void saveCreature(CardHandle handle, const CreatureCard &creature);
+
+private:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Start of a frame: the entries and cards that existed when it was opened.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct Frame
+  {
+    size_t entryCount;
+    size_t poolSize;
+  };
+
+  void nextSerial();
+
+  bool recording = false;
+  uint32_t serial = 0; // stamp of the innermost frame, renewed whenever the innermost frame changes
+  std::vector<UndoEntry> entries;
+  std::vector<Frame> frames;
+  std::vector<CreatureCard> creatures; // saved creature states
+  std::vector<uint32_t> creatureSerial; // per handle: frame in which it was last saved
+  std::vector<std::vector<CardHandle>> storages; // saved deck buffers
+};
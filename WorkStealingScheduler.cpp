@@ -0,0 +1,118 @@
+// --------------------------- WorkStealingScheduler.cpp ---------------------------
+//
+// Implements the WorkStealingScheduler fork-join task runner.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#include "WorkStealingScheduler.hpp"
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Constructs a scheduler for the given number of threads.
+///
+/// @param threads Number of worker threads, 0 for one per hardware thread
+///
+//---------------------------------------------------------------------------------------------------------------------
+WorkStealingScheduler::WorkStealingScheduler(unsigned threads)
+  : threadCount(threads)
+{
+  if (threadCount == 0)
+  {
+    threadCount = max(1u, thread::hardware_concurrency());
+  }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Takes the most recently queued task of the worker's own queue.
+///
+/// @param queue Queue of the calling worker
+/// @param index Receives the task index
+///
+/// @return false if the queue is empty
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool WorkStealingScheduler::popOwn(WorkerQueue &queue, size_t &index)
+{
+  lock_guard<mutex> guard(queue.lock);
+  if (queue.tasks.empty()) return false;
+  index = queue.tasks.back();
+  queue.tasks.pop_back();
+  return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Steals the oldest task of another worker, visiting the victims round-robin starting after the thief.
+///
+/// @param queues All worker queues
+/// @param thief  Worker that is out of work
+/// @param index  Receives the task index
+///
+/// @return false if every queue is empty (no task is ever added later, so the thief can stop)
+///
+//---------------------------------------------------------------------------------------------------------------------
+bool WorkStealingScheduler::steal(vector<WorkerQueue> &queues, unsigned thief, size_t &index)
+{
+  for (unsigned offset = 1; offset < threadCount; ++offset)
+  {
+    WorkerQueue &victim = queues[(thief + offset) % threadCount];
+    lock_guard<mutex> guard(victim.lock);
+    if (!victim.tasks.empty())
+    {
+      index = victim.tasks.front();
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Deals the tasks out in contiguous blocks and runs the workers until all queues are drained.
+///
+/// @param count Number of tasks
+/// @param task  Callable invoked as task(index, worker)
+///
+//---------------------------------------------------------------------------------------------------------------------
+void WorkStealingScheduler::run(size_t count, const function<void(size_t, unsigned)> &task)
+{
+  vector<WorkerQueue> queues(threadCount);
+  for (unsigned w = 0; w < threadCount; ++w)
+  {
+    size_t begin = count * w / threadCount;
+    size_t end = count * (w + 1) / threadCount;
+    for (size_t i = end; i > begin; --i)
+    {
+      queues[w].tasks.push_back(i - 1); // own pops come from the back: block is worked front to back
+    }
+  }
+
+  auto worker = [&](unsigned id)
+  {
+    size_t index;
+    while (popOwn(queues[id], index) || steal(queues, id, index))
+    {
+      task(index, id);
+    }
+  };
+
+  vector<thread> threads;
+  threads.reserve(threadCount - 1);
+  for (unsigned w = 1; w < threadCount; ++w)
+  {
+    threads.emplace_back(worker, w);
+  }
+  worker(0); // the calling thread is worker 0
+  for (thread &t: threads)
+  {
+    t.join();
+  }
+}
@@ -0,0 +1,71 @@
+// --------------------------- WorkStealingScheduler.hpp ---------------------------
+//
+// Declares the WorkStealingScheduler, a small fork-join helper that runs a
+// fixed number of independent tasks on worker threads. Every worker owns a
+// task queue and steals from the others once its own queue runs dry.
+//
+// Group: 051
+//
+// Author: Miloš Đukarić, Florian Kerman, Stefan Jović
+// ------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Runs tasks 0..count-1 on a set of worker threads. Tasks are dealt out in contiguous blocks, each
+/// worker pops from the back of its own queue and steals from the front of other queues when idle,
+/// so uneven task lengths (short and long games) still keep every core busy.
+///
+//---------------------------------------------------------------------------------------------------------------------
+class WorkStealingScheduler
+{
+public:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @param threads Number of worker threads (0 selects the hardware concurrency)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  explicit WorkStealingScheduler(unsigned threads);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Executes task(index, worker) for every index in [0, count) and returns when all are done.
+  /// The worker number lets tasks use per-thread state without locking.
+  ///
+  /// @param count Number of tasks
+  /// @param task  Callable invoked once per task index
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void run(size_t count, const std::function<void(size_t index, unsigned worker)> &task);
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// @return Number of worker threads
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  unsigned getThreadCount() const { return threadCount; }
+
+private:
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Task queue of one worker, padded to its own cache line.
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  struct alignas(64) WorkerQueue
+  {
+    std::mutex lock;
+    std::deque<size_t> tasks;
+  };
+
+  unsigned threadCount;
+
+  bool popOwn(WorkerQueue &queue, size_t &index);
+
+  bool steal(std::vector<WorkerQueue> &queues, unsigned thief, size_t &index);
+};
@@ -8,8 +8,9 @@
 // Author: Miloš Đukarić, Florian Kerman, Stefan Jović
 // ------------------------------------------------------------------------
 #include "Zone.hpp"
+#include "StateHash.hpp"
+#include "UndoJournal.hpp"
 #include <iostream>
-#include <sstream>
 #include <algorithm>
 
 using namespace std; // bring std names into this file
@@ -23,8 +24,8 @@ using namespace std; // bring std names into this file
 //---------------------------------------------------------------------------------------------------------------------
 Zone::Zone(char marker)
   : zoneChar(marker)
-    , slots(7, nullptr)
 {
+  slots.fill(NO_CARD);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -32,20 +33,20 @@ Zone::Zone(char marker)
 /// Places or overwrites a card in the specified slot index (0-based).
 ///
 /// @param index Slot index in the range [0,6]
-/// @param card Shared pointer to the card to place
+/// @param card Handle of the card to place
 ///
 //---------------------------------------------------------------------------------------------------------------------
-void Zone::addCard(int index, shared_ptr<Card> card)
+void Zone::addCard(int index, CardHandle card)
 {
   if (index >= 0 && index < static_cast<int>(slots.size()))
   {
-    slots[index] = card;
+    setSlot(index, card);
   }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
-/// Removes a card from the specified slot by setting it to nullptr.
+/// Removes a card from the specified slot by setting it to NO_CARD.
 ///
 /// @param index Slot index in the range [0,6]
 ///
@@ -54,7 +55,7 @@ void Zone::removeCard(int index)
 {
   if (index >= 0 && index < static_cast<int>(slots.size()))
   {
-    slots[index] = nullptr;
+    setSlot(index, NO_CARD);
   }
 }
 
@@ -65,79 +66,72 @@ void Zone::removeCard(int index)
 //---------------------------------------------------------------------------------------------------------------------
 void Zone::clear()
 {
-  fill(slots.begin(), slots.end(), nullptr);
+  for (int i = 0; i < static_cast<int>(slots.size()); ++i)
+  {
+    setSlot(i, NO_CARD);
+  }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
-/// Prints a 4-line ASCII representation of the zone, formatted as 7 slots side by side.
-/// Each slot is rendered using the card's printCardDetails output.
+/// Writes a slot, recording the old handle in the undo journal and updating the state hash.
+///
+/// @param index 0-based slot index (valid)
+/// @param card  New handle of the slot
 ///
 //---------------------------------------------------------------------------------------------------------------------
-void Zone::printZone() const
+void Zone::setSlot(int index, CardHandle card)
 {
-  const string gap = "   "; // 3-space gap
-  const int cellWidth = 9;
-  const string blank(cellWidth, ' ');
-
-  // Prepare 4-line art for each of the 7 slots
-  vector<array<string, 4> > art(7);
-  for (int i = 0; i < 7; ++i)
+  CardHandle &slot = slots[index];
+  if (journal) journal->save(slot);
+  if (hash)
   {
-    if (slots[i])
-    {
-      // Capture the card's ASCII art via printCardDetails()
-      ostringstream oss;
-      auto *oldBuf = cout.rdbuf(oss.rdbuf());
-      slots[i]->printCardDetails();
-      cout.rdbuf(oldBuf);
+    uint64_t slotId = firstSlotId + index;
+    if (slot != NO_CARD) hash->toggle(HashFeature::CardInZone, slot, slotId);
+    if (card != NO_CARD) hash->toggle(HashFeature::CardInZone, card, slotId);
+  }
+  slot = card;
+}
 
-      // Split into non-empty lines
-      vector<string> lines;
-      istringstream ls(oss.str());
-      for (string ln; getline(ls, ln);)
-      {
-        if (!ln.empty()) lines.push_back(ln);
-      }
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Appends a 4-line ASCII representation of the zone, formatted as 7 slots side by side.
+/// Each slot shows the card's cached tile, so the art of a card is only rendered again
+/// once its visible stats change.
+///
+/// @param out   Buffer the zone rows are appended to
+/// @param tiles Cache supplying the rendered card tiles
+///
+//---------------------------------------------------------------------------------------------------------------------
+void Zone::printZone(string &out, CardTileCache &tiles) const
+{
+  const char *gap = "   "; // 3-space gap
 
-      // Left-align each line into a cellWidth-wide string
-      for (int r = 0; r < 4; ++r)
-      {
-        if (r < static_cast<int>(lines.size()))
-        {
-          const string &ln = lines[r];
-          art[i][r] = ln + string(cellWidth - ln.size(), ' ');
-        }
-        else
-        {
-          art[i][r] = blank;
-        }
-      }
-    }
-    else
-    {
-      // Empty slot: fill entire cell with spaces
-      for (int r = 0; r < 4; ++r)
-      {
-        art[i][r] = blank;
-      }
-    }
+  // Look up the 4-line art of each of the 7 slots
+  array<const CardTile *, 7> art;
+  for (int i = 0; i < 7; ++i)
+  {
+    art[i] = (slots[i] != NO_CARD) ? &tiles.get(*pool->get(slots[i])) : &CardTileCache::blank();
   }
 
-  // Now print each of the 4 rows
-  for (int row = 0; row < 4; ++row)
+  // Now append each of the 4 rows
+  for (int row = 0; row < TILE_ROWS; ++row)
   {
     // Left marker + gap
-    cout << zoneChar << gap;
+    out += zoneChar;
+    out += gap;
     // First slot
-    cout << art[0][row];
+    out += (*art[0])[row];
     // Remaining slots (prefix each with gap)
     for (int i = 1; i < 7; ++i)
     {
-      cout << gap << art[i][row];
+      out += gap;
+      out += (*art[i])[row];
     }
     // Trailing gap + marker, then newline
-    cout << gap << zoneChar << "\n";
+    out += gap;
+    out += zoneChar;
+    out += '\n';
   }
 }
 
@@ -163,7 +157,7 @@ bool Zone::isOccupied(const std::string &slot) const
     return false; // out of bounds
   }
 
-  return slots[index] != nullptr;
+  return slots[index] != NO_CARD;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -179,27 +173,45 @@ Card *Zone::getCard(int index) const
 {
   if (index >= 0 && index < static_cast<int>(slots.size()))
   {
-    return slots[index].get();
+    return pool->get(slots[index]);
   }
   return nullptr;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 ///
-/// Extracts a card from a slot, returning ownership and clearing the slot.
+/// Returns the handle at the given slot index.
+///
+/// @param index Slot index (0-based)
+///
+/// @return Handle of the card, or NO_CARD if empty or invalid
+///
+//---------------------------------------------------------------------------------------------------------------------
+CardHandle Zone::getHandle(int index) const
+{
+  if (index >= 0 && index < static_cast<int>(slots.size()))
+  {
+    return slots[index];
+  }
+  return NO_CARD;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+///
+/// Extracts a card from a slot and clears the slot.
 ///
 /// @param index Slot index (0-based)
 ///
-/// @return Shared pointer to the card, or nullptr if empty or invalid
+/// @return Handle of the card, or NO_CARD if empty or invalid
 ///
 //---------------------------------------------------------------------------------------------------------------------
-shared_ptr<Card> Zone::extractCard(int index)
+CardHandle Zone::extractCard(int index)
 {
   if (index >= 0 && index < static_cast<int>(slots.size()))
   {
-    auto card = slots[index];
-    slots[index] = nullptr;
+    CardHandle card = slots[index];
+    setSlot(index, NO_CARD);
     return card;
   }
-  return nullptr;
+  return NO_CARD;
 }
@@ -11,9 +11,9 @@
 
 #include <vector>
 #include <array>
-#include <memory>
 #include <string>
-#include "Card.hpp"
+#include "CardPool.hpp"
+#include "CardTile.hpp"
 
 using namespace std; // bring std names into this header for brevity
 
@@ -36,15 +36,47 @@ public:
   //---------------------------------------------------------------------------------------------------------------------
   explicit Zone(char marker);
 
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Sets the pool the slot handles of this zone refer to.
+  ///
+  /// @param cards Card pool of the owning game
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void bindCardPool(CardPool &cards) { pool = &cards; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Sets the journal that records the slot changes of this zone.
+  ///
+  /// @param undo Journal of the owning game (nullptr for none)
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void bindUndoJournal(UndoJournal *undo) { journal = undo; }
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Sets the state hash that tracks which card is in which slot of this zone.
+  ///
+  /// @param stateHash Hash of the owning game (nullptr for none)
+  /// @param zoneId    Number of the zone on the board (0-3), distinguishing its slots from others
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  void bindStateHash(StateHash *stateHash, int zoneId)
+  {
+    hash = stateHash;
+    firstSlotId = static_cast<uint8_t>(zoneId * 7);
+  }
+
   //---------------------------------------------------------------------------------------------------------------------
   ///
   /// Places or overwrites a card in a given slot (0–6).
   ///
   /// @param index 0-based slot index
-  /// @param card Shared pointer to a Card to insert; nullptr empties the slot
+  /// @param card Handle of the card to insert; NO_CARD empties the slot
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  void addCard(int index, shared_ptr<Card> card);
+  void addCard(int index, CardHandle card);
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -64,14 +96,17 @@ public:
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
-  /// Prints the zone as a 4-row ASCII art representation.
+  /// Appends the zone as a 4-row ASCII art representation to a text buffer.
   ///
   /// - Each slot is 9 characters wide
   /// - 3 spaces separate slots
   /// - Zone edges are marked with zoneChar
   ///
+  /// @param out   Buffer the zone rows are appended to
+  /// @param tiles Cache supplying the rendered card tiles
+  ///
   //---------------------------------------------------------------------------------------------------------------------
-  void printZone() const;
+  void printZone(std::string &out, CardTileCache &tiles) const;
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -86,14 +121,25 @@ public:
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
-  /// Extracts a card from a slot, transferring ownership and clearing the slot.
+  /// Returns the handle stored in the given slot.
+  ///
+  /// @param index 0-based index of the slot
+  ///
+  /// @return Handle of the card, NO_CARD if the slot is empty or the index invalid
+  ///
+  //---------------------------------------------------------------------------------------------------------------------
+  CardHandle getHandle(int index) const;
+
+  //---------------------------------------------------------------------------------------------------------------------
+  ///
+  /// Extracts a card from a slot and clears the slot.
   ///
   /// @param index 0-based slot index
   ///
-  /// @return Shared pointer to the extracted card, or nullptr if empty
+  /// @return Handle of the extracted card, or NO_CARD if empty
   ///
   //---------------------------------------------------------------------------------------------------------------------
-  shared_ptr<Card> extractCard(int index);
+  CardHandle extractCard(int index);
 
   //---------------------------------------------------------------------------------------------------------------------
   ///
@@ -108,5 +154,11 @@ public:
 
 private:
   char zoneChar; // Border character on each row start/end
-  vector<shared_ptr<Card> > slots; // Exactly 7 card pointers (may be nullptr)
+  array<CardHandle, 7> slots; // Exactly 7 card handles (may be NO_CARD)
+  CardPool *pool = nullptr; // Pool the handles refer to
+  UndoJournal *journal = nullptr; // Records slot changes while an action can be undone
+  StateHash *hash = nullptr; // Hash of the owning game
+  uint8_t firstSlotId = 0; // Board-wide number of slot 0, used in the hash
+
+  void setSlot(int index, CardHandle card);
 };
@@ -1,11 +1,127 @@
 #include "Game.hpp"
+#include "CommandSource.hpp"
+#include "Simulation.hpp"
+#include "Perft.hpp"
+#include "MctsBot.hpp"
+#include "GreedyBot.hpp"
+#include "TranspositionTable.hpp"
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
 #include <new>         // For std::bad_alloc
 #include <exception>   // For std::exception
 
 using namespace std;
 
+/**
+ * @brief Runs a batch of headless games driven by a command script or the greedy bot.
+ *
+ * Usage: --headless <GAME_CONFIG> <MESSAGE_CONFIG> <SCRIPT|greedy> [<GAMES>]
+ * The script is replayed in a loop for every game, so it must contain a "done" command.
+ * With "greedy" instead of a script, the GreedyBot plays both seats.
+ * Prints the result distribution, and the throughput (games/second) on stderr.
+ *
+ * @param argc Number of command-line arguments
+ * @param argv Array of command-line argument strings
+ * @return int Exit code: 0 = success, 2 = invalid usage
+ */
+static int runHeadless(int argc, char **argv)
+{
+  if (argc != 5 && argc != 6)
+  {
+    cout << "[ERROR] Wrong number of parameters.\n";
+    return 2;
+  }
+
+  size_t games = (argc == 6) ? stoul(argv[5]) : 1;
+  HeadlessSimulator simulator(argv[2], argv[3]);
+  if (string(argv[4]) == "greedy")
+  {
+    GreedyBot bot;
+    simulator.run(games, bot).print(cout, cerr);
+    return 0;
+  }
+
+  vector<string> script = ScriptedCommandSource::loadScript(argv[4]);
+  if (!ScriptedCommandSource::endsTurn(script))
+  {
+    cout << "[ERROR] The script needs a done command to make progress.\n";
+    return 2;
+  }
+
+  ScriptedCommandSource source(script, true);
+  simulator.run(games, source).print(cout, cerr);
+  return 0;
+}
+
+/**
+ * @brief Counts the action tree of the opening position (perft) and prints the breakdown.
+ *
+ * Usage: --perft <GAME_CONFIG> <MESSAGE_CONFIG> <DEPTH> [HASH_MB] [THREADS]
+ * Prints the leaf node count below every legal first action and the total, and nodes/second
+ * on stderr.
+ * With HASH_MB > 0, subtree counts are shared through a transposition table of that size;
+ * THREADS (default 1, 0 = all cores) count the root moves in parallel.
+ *
+ * @param argc Number of command-line arguments
+ * @param argv Array of command-line argument strings
+ * @return int Exit code: 0 = success, 2 = invalid usage
+ */
+static int runPerft(int argc, char **argv)
+{
+  if (argc < 5 || argc > 7 || stoi(argv[4]) < 1)
+  {
+    cout << "[ERROR] Wrong number of parameters.\n";
+    return 2;
+  }
+
+  size_t hashMegabytes = (argc >= 6) ? stoul(argv[5]) : 0;
+  unsigned threads = (argc >= 7) ? static_cast<unsigned>(stoul(argv[6])) : 1;
+  unique_ptr<TranspositionTable> table;
+  if (hashMegabytes > 0) table = make_unique<TranspositionTable>(hashMegabytes);
+
+  Game game(argv[2], argv[3]);
+  perftDivide(game, stoi(argv[4]), table.get(), threads).print(cout, cerr);
+  return 0;
+}
+
+/**
+ * @brief Plays an interactive game against the built-in MCTS opponent.
+ *
+ * Usage: <GAME_CONFIG> <MESSAGE_CONFIG> --ai <SEAT> [<MS>] [<THREADS>]
+ * The bot plays SEAT (1 or 2) with MS milliseconds per action (default 200) on THREADS search
+ * threads (default: all cores); the other seat reads commands from the terminal. The bot's
+ * commands are echoed after its prompt. The bot searches random deals of the cards it cannot see
+ * (both deck orders and the human's hand), so it plays without knowing future draws.
+ *
+ * @param game The game to play
+ * @param argc Number of command-line arguments
+ * @param argv Array of command-line argument strings
+ * @return int Exit code: 0 = success, 2 = invalid usage
+ */
+static int runAgainstBot(Game &game, int argc, char **argv)
+{
+  int seat = stoi(argv[4]);
+  if (seat != 1 && seat != 2)
+  {
+    cout << "[ERROR] Wrong number of parameters.\n";
+    return 2;
+  }
+
+  MctsConfig config;
+  if (argc >= 6) config.timeLimitMs = stoi(argv[5]);
+  if (argc >= 7) config.threads = static_cast<unsigned>(stoul(argv[6]));
+
+  StreamCommandSource human(cin);
+  MctsBot bot(config);
+  SeatedCommandSource seats(seat == 1 ? static_cast<CommandSource &>(bot) : human,
+                            seat == 2 ? static_cast<CommandSource &>(bot) : human);
+  seats.setEcho(seat, &cout);
+  return game.run(seats);
+}
+
 /**
  * @brief Entry point for the card game application.
  *
@@ -22,12 +138,30 @@ int main(int argc, char **argv)
 {
   try
   {
+    // ---------------------------------------------------------------------
+    // Headless batch mode: plays scripted games without terminal I/O.
+    // ---------------------------------------------------------------------
+    if (argc >= 2 && string(argv[1]) == "--headless")
+    {
+      return runHeadless(argc, argv);
+    }
+
+    // ---------------------------------------------------------------------
+    // Perft mode: counts the action tree of the opening position.
+    // ---------------------------------------------------------------------
+    if (argc >= 2 && string(argv[1]) == "--perft")
+    {
+      return runPerft(argc, argv);
+    }
+
     // ---------------------------------------------------------------------
     // Check the number of command-line arguments.
-    // Expect exactly 2 arguments: the game config file and the message config file.
+    // Expect exactly 2 arguments: the game config file and the message config file,
+    // optionally followed by "--ai <SEAT> [<MS>] [<THREADS>]".
     // If not provided, print error message and exit with code 2.
     // ---------------------------------------------------------------------
-    if (argc != 3)
+    bool againstBot = (argc >= 5 && argc <= 7 && string(argv[3]) == "--ai");
+    if (argc != 3 && !againstBot)
     {
       cout << "[ERROR] Wrong number of parameters.\n";
       return 2;
@@ -69,6 +203,10 @@ int main(int argc, char **argv)
     // The return value of game.run() determines the program's exit code.
     // ---------------------------------------------------------------------
     Game game(gameCfg, msgCfg);
+    if (againstBot)
+    {
+      return runAgainstBot(game, argc, argv);
+    }
     return game.run();
   }
   // -------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+#include "Tournament.hpp"
+#include "CommandSource.hpp"
+#include "GreedyBot.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <exception>
+
+using namespace std;
+
+/**
+ * @brief Entry point of the tournament simulator.
+ *
+ * Usage: ./simulator <GAME_CONFIG> <MESSAGE_CONFIG> <DECK_PAIRS> [<SCRIPT|greedy>] [<THREADS>] [<GAMES_PER_PAIR>]
+ *        [<LOCKSTEP>]
+ * Plays every deck pair of DECK_PAIRS headless, driven by the looping SCRIPT or by the GreedyBot
+ * (the default), on THREADS worker threads (default: all cores) and prints the results per pair
+ * and in total. Each worker plays LOCKSTEP games side by side (default 16, 1 = one at a time) and
+ * resolves their battle phases together; the fight kernel in use is reported with the timing.
+ *
+ * @param argc Number of command-line arguments
+ * @param argv Array of command-line argument strings
+ * @return int Exit code: 0 = success, 1 = error, 2 = invalid usage
+ */
+int main(int argc, char **argv)
+{
+  try
+  {
+    if (argc < 4 || argc > 8)
+    {
+      cout << "[ERROR] Wrong number of parameters.\n";
+      return 2;
+    }
+
+    unsigned threads = (argc >= 6) ? static_cast<unsigned>(stoul(argv[5])) : 0;
+    size_t gamesPerPair = (argc >= 7) ? stoul(argv[6]) : 1;
+    size_t lockstep = (argc == 8) ? stoul(argv[7]) : LockstepSimulator::DEFAULT_GAMES;
+    if (lockstep == 0)
+    {
+      cout << "[ERROR] LOCKSTEP must be at least 1.\n";
+      return 2;
+    }
+
+    bool greedy = (argc == 4 || string(argv[4]) == "greedy");
+    vector<string> script;
+    if (!greedy)
+    {
+      script = ScriptedCommandSource::loadScript(argv[4]);
+      if (!ScriptedCommandSource::endsTurn(script))
+      {
+        cout << "[ERROR] The script needs a done command to make progress.\n";
+        return 2;
+      }
+    }
+
+    vector<Matchup> matchups = Tournament::loadMatchups(argv[3]);
+    Tournament tournament(argv[1], argv[2]);
+    TournamentReport report = tournament.run(matchups, gamesPerPair, threads, [&script, greedy]()
+    {
+      if (greedy) return unique_ptr<CommandSource>(new GreedyBot());
+      return unique_ptr<CommandSource>(new ScriptedCommandSource(script, true));
+    }, lockstep);
+
+    for (size_t i = 0; i < report.matchups.size(); ++i)
+    {
+      const SimulationReport &pair = report.matchups[i];
+      cout << "Pair " << i + 1 << ": P1 " << pair.p1Wins << " / P2 " << pair.p2Wins
+          << " / Tie " << pair.ties << " / Unfinished " << pair.unfinished << "\n";
+    }
+    report.total.print(cout, cerr);
+    cerr << "Fight kernel: " << FightBatch::kernelName() << "\n";
+    return 0;
+  }
+  catch (const std::exception &e)
+  {
+    cerr << "[ERROR] " << e.what() << endl;
+    return 1;
+  }
+}